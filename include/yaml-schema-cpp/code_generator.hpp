@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Generate a C++ header specialized for a schema, so that inputs can be validated without schema files.
+ *
+ * The header contains (inside namespace 'name_space'):
+ *  - A plain struct for the schema (named as the schema in CamelCase), and for each map and custom type in it.
+ *  - 'validateAndLoad(const YAML::Node&)' returning the struct (throws std::runtime_error if not valid) and
+ *    'validateAndLoad(const YAML::Node&, Struct&, std::string& error)' returning false if not valid.
+ * Type checks, sizes, DEFAULT, VALUE and OPTIONS are inlined. The generated code only depends on yaml-cpp
+ * (and yaml_conversion.hpp if the schema has Eigen types, expression.hpp of this library if it has expressions in
+ * MANDATORY, evaluated at runtime).
+ *
+ * Differences with applySchema(): validation stops at the first error and the input node is not modified.
+ * Schemas with derived types are not supported (their schema depends on the input).
+ *
+ * @param name_schema schema name (searched in folders_schema)
+ * @param name_space namespace of the generated code (if empty, the schema name)
+ * @return the header contents (throws std::runtime_error if the schema could not be loaded or is not supported)
+ */
+std::string generateCode(const std::string&              name_schema,
+                         const std::vector<std::string>& folders_schema,
+                         const std::string&              name_space = "",
+                         bool                            override   = true);
+
+/**
+ * @brief Generate the header (see generateCode()) and write it in filepath (overwritten if exists)
+ * @return the path of the generated file
+ */
+std::string generateCodeFile(std::string                     filepath,
+                             const std::string&              name_schema,
+                             const std::vector<std::string>& folders_schema,
+                             const std::string&              name_space = "",
+                             bool                            override   = true);
+
+}  // namespace yaml_schema_cpp
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "yaml-cpp/yaml.h"
 
 namespace yaml_schema_cpp
@@ -12,6 +14,13 @@ bool checkExpression(const YAML::Node& node_expression, const YAML::Node& node_s
 
 bool evalExpression(std::string expression_str, const YAML::Node& node_input_parent);
 
+/** @brief Evaluates the expression for all nodes (e.g. the elements of a sequence) compiling it only once.
+ *
+ * The variables of each node are gathered in columns and the expression is evaluated in a single loop. The result is
+ * the same as calling evalExpression() for each node (throws the error of the first node that fails).
+ */
+std::vector<bool> evalExpressionBatch(std::string expression_str, const std::vector<YAML::Node>& nodes_input_parent);
+
 void preProcessExpression(std::string& expression_str);
 
 }  // namespace yaml_schema_cpp
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+#include "yaml-schema-cpp/yaml_hash.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Set of allowed values (OPTIONS) of a specification, normalized for O(1) membership tests.
+ * Each option is stored as its canonical key (see canonicalKey()), so that a value is in the set
+ * iff compare() with any of the options returns true.
+ * Options without exact canonical key (e.g. Eigen types, compared with tolerance) fall back to linear search.
+ */
+class OptionsSet
+{
+  public:
+    OptionsSet(const YAML::Node&               options_node,
+               const std::string&              type,
+               const YAML::Node&               node_schema_type,
+               const std::vector<std::string>& folders_schema);
+
+    bool contains(const YAML::Node& node) const;
+
+  private:
+    YAML::Node                      options_node_;
+    std::string                     type_;
+    YAML::Node                      node_schema_type_;
+    std::vector<std::string>        folders_schema_;
+    std::unordered_set<std::string> keys_;
+    bool                            exact_;  // all options have canonical key
+};
+
+/**
+ * @brief A schema loaded, flattened and checked (see loadSchema()) together with the normalized
+ * OPTIONS of all its specifications.
+ * The node is shared by all users of the cache and should NOT be modified.
+ */
+struct CompiledSchema
+{
+    std::string                                                        path;
+    std::vector<LoadedFile>                                            files;  // schema file and followed files
+    YAML::Node                                                         node;
+    std::unordered_map<const void*, std::shared_ptr<const OptionsSet>> options;  // by identity of OPTIONS node
+    mutable std::atomic<long long> check_time{0};  // last check of the files (steady clock, nanoseconds)
+
+    /**
+     * @brief Normalized OPTIONS of a specification of this schema (no lock, the compiled schema is not modified)
+     * @param options_node the OPTIONS node of a specification of node
+     * @return the options set, nullptr if options_node does not belong to this schema
+     */
+    std::shared_ptr<const OptionsSet> findOptions(const YAML::Node& options_node) const;
+};
+
+/**
+ * @brief Get a compiled schema from the process-wide schema cache (thread safe).
+ * The schema is loaded (see loadSchema()) and compiled the first time or if any of its files (the schema file or the
+ * files included via 'follow') was modified. The files are checked at most once per check interval (see
+ * setSchemaCacheCheckInterval()).
+ *
+ * @return the compiled schema, nullptr if it could not be loaded (error written in log)
+ */
+std::shared_ptr<const CompiledSchema> getCompiledSchema(const std::string&              name_schema,
+                                                        const std::vector<std::string>& folders_schema,
+                                                        std::stringstream&              log,
+                                                        bool                            override = true);
+
+/**
+ * @brief Load and compile in background the schemas referenced by a schema, so that they are already in the cache
+ * when the validation reaches them.
+ * The schema files are scanned (in parallel) for the referenced schemas: TYPE and BASE of its specifications and the
+ * files included with 'follow', recursively. Then they are compiled with getCompiledSchema() (in parallel, the
+ * referenced schemas before the schemas referencing them) and finally the schema itself.
+ *
+ * @param n_threads maximum number of files loaded or compiled at the same time
+ * @return future with the result: if all schemas could be compiled (errors will be reported when using them).
+ * NOTE: the returned future has to be kept while prefetching, its destruction waits until it is done.
+ */
+std::shared_future<bool> prefetchSchemas(const std::string&              name_schema,
+                                         const std::vector<std::string>& folders_schema,
+                                         bool                            override  = true,
+                                         unsigned int                    n_threads = 4);
+
+/**
+ * @brief Minimum time between two checks of the files of a cached schema (default 1 second, 0 to check them always)
+ */
+void setSchemaCacheCheckInterval(double seconds);
+
+/**
+ * @brief Remove all compiled schemas from the cache
+ */
+void clearSchemaCache();
+
+}  // namespace yaml_schema_cpp
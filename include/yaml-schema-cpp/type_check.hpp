@@ -19,37 +19,48 @@ namespace yaml_schema_cpp
     }
 
 #if _EIGEN_FOUND == 1
-#define CHECK_TYPE_EIGEN_CASE(size)                                                                                   \
-    if (type == "Vector" #size "d" or type == "Eigen::Vector" #size "d")                                              \
-    {                                                                                                                 \
-        node.as<Eigen::Matrix<double, size, 1> >();                                                                   \
-        return true;                                                                                                  \
-    }                                                                                                                 \
-    if (type == "Matrix" #size "d" or type == "Eigen::Matrix" #size "d")                                              \
-    {                                                                                                                 \
-        node.as<Eigen::Matrix<double, size, size> >();                                                                \
-        return true;                                                                                                  \
-    }
+/**
+ * @brief Eigen matrix type parsed from a type string (see parseEigenType())
+ */
+struct EigenType
+{
+    enum Scalar
+    {
+        DOUBLE,
+        FLOAT,
+        INT
+    };
+    Scalar scalar;
+    int    rows;  // Eigen::Dynamic if dynamic
+    int    cols;  // Eigen::Dynamic if dynamic
+};
 
-#define CHECK_TYPE_EIGEN_CASES                                                                                        \
-    CHECK_TYPE_EIGEN_CASE(1)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(2)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(3)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(4)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(5)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(6)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(7)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(8)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(9)                                                                                          \
-    CHECK_TYPE_EIGEN_CASE(10)                                                                                         \
-    CHECK_TYPE_CASE(Eigen::VectorXd)                                                                                  \
-    CHECK_TYPE_CASE(Eigen::VectorXd)                                                                                  \
-    CHECK_TYPE_CASE(Eigen::MatrixXd)                                                                                  \
-    {                                                                                                                 \
-        using namespace Eigen;                                                                                        \
-        CHECK_TYPE_CASE(VectorXd)                                                                                     \
-        CHECK_TYPE_CASE(MatrixXd)                                                                                     \
-    }
+/**
+ * @brief parse an Eigen matrix type, with or without "Eigen::" prefix:
+ *  - {Vector,RowVector}{N,X}{d,f,i}: e.g. Vector3d, Vector16d, VectorXf, RowVector6i
+ *  - Matrix{N,X}[{N,X}]{d,f,i}: e.g. Matrix3i, MatrixXd, Matrix2Xd, MatrixX3f
+ *  - Matrix<scalar, rows, cols>, Vector<scalar, size>, RowVector<scalar, size>: e.g. Matrix<float, 12, 12>
+ * with scalar double, float or int and sizes positive integers or [Eigen::]Dynamic.
+ *
+ * @param type string specifying a type
+ * @param eigen_type the parsed type
+ * @return if type is an Eigen matrix type
+ */
+bool parseEigenType(const std::string& type, EigenType& eigen_type);
+
+/**
+ * @brief check a node is a matrix without decoding it (see yaml_schema_cpp::conversion::checkMatrix())
+ * Throws YAML::BadConversion otherwise, as node.as<Eigen::Matrix<...> >() would do.
+ *
+ * @param rows, cols fixed sizes or Eigen::Dynamic
+ */
+template <typename _Scalar>
+bool checkNodeAsMatrix(const YAML::Node& node, int rows, int cols)
+{
+    if (not conversion::checkMatrix<_Scalar>(node, rows, cols)) throw YAML::BadConversion(node.Mark());
+    return true;
+}
+bool checkNodeAsMatrix(const YAML::Node& node, const EigenType& eigen_type);
 #endif
 
 #define CHECK_TYPE_BASIC_CASES                                                                                        \
@@ -108,7 +119,7 @@ bool tryNodeAs(const YAML::Node& node, const std::string& type);
 /** Functions to evaluate if a string definig type is in these groups:
  *  - Basic: int, float, string, Eigen types (if eigen installed))
  *  - String
- *  - Eigen: Vector or Matrix dynamic of fixed size (until 10)
+ *  - Eigen: Vector or Matrix of any scalar and size (see parseEigenType())
  *  - Trivial: Basic, string or Eigen
  *  - NonTrivial: rest of types that require schemas to be specified
  */
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Result of a validation stored in the persistent validation cache (see YamlServer::setValidationCache())
+ */
+struct CachedValidation
+{
+    bool        is_valid;
+    std::string log;
+    YAML::Node  node;  // flattened input completed with DEFAULT and VALUE
+};
+
+/**
+ * @brief Fingerprint of the validation of an input file: hash of the library version, the input file (path and
+ * contents), the schema name, override and all schema files in folders_schema (paths, sizes and modification times,
+ * not read). All schema files are included since the schemas of derived types depend on the input.
+ * The files included by the input via 'follow' are checked by loadCachedValidation().
+ *
+ * @return the fingerprint (hexadecimal), empty if the input file cannot be read
+ */
+std::string validationFingerprint(const std::string&              path_input,
+                                  const std::string&              name_schema,
+                                  const std::vector<std::string>& folders_schema,
+                                  bool                            override = true);
+
+/**
+ * @brief Load a validation result from the cache folder
+ * @return false if there is no result for the fingerprint, it cannot be read, it was stored by another version of
+ * the library or any of the files followed by the input has changed since it was stored
+ */
+bool loadCachedValidation(const std::string& cache_folder, const std::string& fingerprint, CachedValidation& cached);
+
+/**
+ * @brief Store a validation result in the cache folder (created if it does not exist), replacing the previous one.
+ * The input and the files followed by it (as loaded for the validation, see loadFile()) are stored with their hash
+ * to be checked when loading.
+ * The result is written to a temporary file that is renamed, so several processes can use the same cache folder
+ * (readers never get a partially written result).
+ *
+ * @return if the result could be stored
+ */
+bool storeCachedValidation(const std::string&             cache_folder,
+                           const std::string&             fingerprint,
+                           const std::vector<LoadedFile>& loaded_files,
+                           const CachedValidation&        cached);
+
+}  // namespace yaml_schema_cpp
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Result of the validation of a document of a batch (see ValidationSession::applySchemaBatch())
+ */
+struct ValidationResult
+{
+    std::string path_input;  // empty if the document was given as a node
+    bool        is_valid;
+    bool        is_skipped;  // not validated (see fail_fast in ValidationSession::applySchemaBatch())
+    std::string log;         // errors
+    YAML::Node  node;        // document after applying the schema (completed with DEFAULT and VALUE)
+    double      time;        // seconds spent loading and validating the document
+};
+
+/**
+ * @brief Validation of many documents against the same set of schemas.
+ * The schemas are compiled once for all documents (see getCompiledSchema() and prefetchSchemas()) and the documents
+ * of a batch are validated in parallel, each one with the same result as YamlServer::applySchema().
+ */
+class ValidationSession
+{
+  public:
+    ValidationSession(const std::vector<std::string>& folders_schema,
+                      bool                            override  = true,
+                      unsigned int                    n_threads = 4);
+
+    /**
+     * @brief Load (see YamlServer::loadYaml()) and validate each file against the schema
+     * @param fail_fast if true, the files not started when a file is found not valid are skipped (not valid)
+     * @return the result of each file, in the same order. Files that cannot be loaded are not valid.
+     */
+    std::vector<ValidationResult> applySchemaBatch(const std::vector<std::string>& paths_input,
+                                                   const std::string&              name_schema,
+                                                   bool                            fail_fast = false) const;
+
+    /**
+     * @brief Validate each node against the schema (the nodes are copied, not modified)
+     * @param fail_fast if true, the nodes not started when a node is found not valid are skipped (not valid)
+     * @return the result of each node, in the same order
+     */
+    std::vector<ValidationResult> applySchemaBatch(const std::vector<YAML::Node>& nodes_input,
+                                                   const std::string&             name_schema,
+                                                   bool                           fail_fast = false) const;
+
+    std::vector<std::string> getFolderSchema() const;
+
+  private:
+    void prefetch(const std::string& name_schema) const;
+
+    std::vector<std::string> folders_schema_;
+
+    bool override_;
+
+    unsigned int n_threads_;
+};
+
+}  // namespace yaml_schema_cpp
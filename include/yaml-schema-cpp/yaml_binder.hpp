@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "yaml-cpp/yaml.h"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Binds fields of the input YAML to C++ variables or setters, so that they are filled during the
+ * validation pass of applySchema() (no second traversal with node["a"]["b"].as<T>()).
+ *
+ * Fields are identified by the same path as in the log: "map/field", "sequence[2]/field".
+ * A bound field is assigned when it is visited by the validation: if it is valid or if it is filled with
+ * its DEFAULT or VALUE. Fields of any type can be bound (custom types need a YAML::convert<T>).
+ * NOTE: Bound variables may be partially filled if the validation fails.
+ *
+ * Example:
+ *   Config       config;
+ *   SchemaBinder binder;
+ *   binder.bind("map1/param1", config.param1)
+ *       .bindSetter<std::string>("param4", [&](const std::string& value) { config.setName(value); });
+ *   server.applySchema("my_schema", binder);
+ */
+class SchemaBinder
+{
+  public:
+    typedef std::function<bool(const YAML::Node&)> NodeSetter;  // false if the node could not be converted
+
+    /**
+     * @brief Bind a field to a variable, it is converted with YAML::convert<T>
+     */
+    template <typename T>
+    SchemaBinder& bind(const std::string& field, T& target)
+    {
+        return bindNode(field, [&target](const YAML::Node& node) { return YAML::convert<T>::decode(node, target); });
+    }
+
+    /**
+     * @brief Bind a field to a setter, the value is converted with YAML::convert<T>
+     */
+    template <typename T, typename Setter>
+    SchemaBinder& bindSetter(const std::string& field, Setter setter)
+    {
+        return bindNode(field, [setter](const YAML::Node& node) {
+            T value;
+            if (not YAML::convert<T>::decode(node, value)) return false;
+            setter(value);
+            return true;
+        });
+    }
+
+    /**
+     * @brief Bind a field to a setter taking the YAML node
+     */
+    SchemaBinder& bindNode(const std::string& field, NodeSetter setter);
+
+    bool isBound(const std::string& field) const;
+
+    /**
+     * @brief Assign a node to the field binding (if bound)
+     * @return false if the field is bound and the node could not be converted (error written in log)
+     */
+    bool assign(const std::string& field, const YAML::Node& node, std::stringstream& log) const;
+
+    std::size_t size() const;
+
+  private:
+    std::unordered_map<std::string, NodeSetter> setters_;
+};
+
+}  // namespace yaml_schema_cpp
@@ -12,7 +12,338 @@
 #include <eigen3/Eigen/Geometry>
 
 // stl
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace yaml_schema_cpp
+{
+namespace conversion
+{
+/** \brief Fast non-throwing parsing of plain decimal numbers.
+ *
+ * Only strings made of digits, sign, '.' and exponent are parsed here (strtod/strtoll, no stringstream).
+ * Anything else (hex, octal, .inf, .nan...) returns false and is left to YAML::convert<T>::decode.
+ */
+inline bool isPlainNumber(const std::string& str, bool floating_point)
+{
+    if (str.empty()) return false;
+    for (auto c : str)
+        if (not(std::isdigit((unsigned char)c) or c == '-' or c == '+' or
+                (floating_point and (c == '.' or c == 'e' or c == 'E'))))
+            return false;
+    return true;
+}
+
+inline float parseFloatingPoint(const char* str, char** end, float)
+{
+    return std::strtof(str, end);
+}
+inline double parseFloatingPoint(const char* str, char** end, double)
+{
+    return std::strtod(str, end);
+}
+inline long double parseFloatingPoint(const char* str, char** end, long double)
+{
+    return std::strtold(str, end);
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type fastParse(const std::string& str, T& value)
+{
+    if (not isPlainNumber(str, true)) return false;
+
+    char* end;
+    T     result = parseFloatingPoint(str.c_str(), &end, T());
+    if (end != str.c_str() + str.size() or std::isinf(result)) return false;  // overflow left to yaml-cpp
+
+    value = result;
+    return true;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value and not std::is_same<T, bool>::value, bool>::type fastParse(
+    const std::string& str,
+    T&                 value)
+{
+    // leading zeros are octal for yaml-cpp, negative values not allowed for unsigned
+    auto digits = str.find_first_not_of("+-");
+    if (not isPlainNumber(str, false) or digits > 1 or digits == std::string::npos or
+        (str.size() > digits + 1 and str[digits] == '0') or (std::is_unsigned<T>::value and str[0] == '-'))
+        return false;
+
+    char* end;
+    errno            = 0;
+    long long result = std::strtoll(str.c_str(), &end, 10);
+    if (end != str.c_str() + str.size() or errno == ERANGE or
+        result < (long long)std::numeric_limits<T>::min() or
+        (result > 0 and (unsigned long long)result > (unsigned long long)std::numeric_limits<T>::max()))
+        return false;
+
+    value = (T)result;
+    return true;
+}
+
+template <typename T>
+typename std::enable_if<not std::is_arithmetic<T>::value or std::is_same<T, bool>::value, bool>::type fastParse(
+    const std::string&,
+    T&)
+{
+    return false;
+}
+
+/** \brief Decode a scalar without throwing, using fastParse() when possible
+ */
+template <typename T>
+bool decodeScalar(const YAML::Node& node, T& value)
+{
+    if (node.IsScalar() and fastParse(node.Scalar(), value)) return true;
+    return YAML::convert<T>::decode(node, value);
+}
+
+/** \brief Stream to format floating point numbers, reused by each thread: classic locale (independent of the C and
+ * global locales, always '.' as decimal point) and max_digits10 precision (decoded back to the same value)
+ */
+template <typename T>
+std::ostringstream& floatingPointStream()
+{
+    thread_local std::ostringstream stream;
+    thread_local bool               configured = false;
+    if (not configured)
+    {
+        stream.imbue(std::locale::classic());
+        stream.precision(std::numeric_limits<T>::max_digits10);
+        configured = true;
+    }
+    stream.str("");
+    return stream;
+}
+
+/** \brief Encode a scalar (same output as YAML::convert<T>::encode in the classic locale, without creating a
+ * stringstream for each number)
+ */
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, YAML::Node>::type encodeScalar(const T& value)
+{
+    if (std::isnan(value)) return YAML::Node(".nan");
+    if (std::isinf(value)) return YAML::Node(value > 0 ? ".inf" : "-.inf");
+
+    auto& stream = floatingPointStream<T>();
+    stream << value;
+    return YAML::Node(stream.str());
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value and not std::is_same<T, bool>::value, YAML::Node>::type
+encodeScalar(const T& value)
+{
+    return YAML::Node(std::to_string(value));
+}
+
+template <typename T>
+typename std::enable_if<not std::is_arithmetic<T>::value or std::is_same<T, bool>::value, YAML::Node>::type
+encodeScalar(const T& value)
+{
+    return YAML::Node(value);
+}
+
+/** \brief Encode a YAML sequence from any Eigen dense expression, row by row
+ */
+template <typename Derived>
+YAML::Node encodeMatrix(const Eigen::DenseBase<Derived>& matrix)
+{
+    YAML::Node node;
+
+    for (Eigen::Index i = 0; i < matrix.rows(); ++i)
+        for (Eigen::Index j = 0; j < matrix.cols(); ++j) node.push_back(encodeScalar(matrix(i, j)));
+
+    return node;
+}
+
+/** \brief Get the sequence of entries and the size of a YAML matrix without decoding it.
+ *
+ * Accepts the formats of YAML::convert<Eigen::Matrix<...> >::decode: ````[ v1, v2, ...]```` (for
+ * matrices with at least one fixed dimension) or ````[ [ rows, cols ], [v1, v2, ...] ]````.
+ *
+ * @param rows, cols fixed sizes or Eigen::Dynamic, on success the actual sizes
+ * @param values the sequence of entries (row by row)
+ * @param error the reason of failure
+ */
+inline bool matrixValues(const YAML::Node& node, int& rows, int& cols, YAML::Node& values, std::string& error)
+{
+    if (not node.IsSequence())
+    {
+        error = "Bad matrix specification";
+        return false;
+    }
+
+    // ==========================================================================================
+    // Special case empty vector/matrix
+    if (node.size() == 0)
+    {
+        if (rows != Eigen::Dynamic and cols != Eigen::Dynamic)
+        {
+            error = "Empty input sequence with not dynamic matrix";
+            return false;
+        }
+        values = node;
+        if (rows == Eigen::Dynamic) rows = 0;
+        if (cols == Eigen::Dynamic) cols = 0;
+        return true;
+    }
+
+    // sizes given by YAML
+    if (node[0].IsSequence())
+    {
+        int yaml_rows, yaml_cols;
+        if (node.size() != 2 or node[0].size() != 2 or not node[1].IsSequence() or
+            not YAML::convert<int>::decode(node[0][0], yaml_rows) or
+            not YAML::convert<int>::decode(node[0][1], yaml_cols) or yaml_rows < 0 or yaml_cols < 0 or
+            node[1].size() != (std::size_t)yaml_rows * yaml_cols)
+        {
+            error = "Bad matrix specification";
+            return false;
+        }
+        if (rows != Eigen::Dynamic and cols != Eigen::Dynamic and (rows != yaml_rows or cols != yaml_cols))
+        {
+            error = "Wrong size";
+            return false;
+        }
+        if (rows != Eigen::Dynamic and rows != yaml_rows)
+        {
+            error = "Wrong number of rows";
+            return false;
+        }
+        if (cols != Eigen::Dynamic and cols != yaml_cols)
+        {
+            error = "Wrong number of cols";
+            return false;
+        }
+        values = node[1];
+        rows   = yaml_rows;
+        cols   = yaml_cols;
+        return true;
+    }
+
+    // sizes deduced
+    // If full dynamic -> error
+    if (rows == Eigen::Dynamic and cols == Eigen::Dynamic)
+    {
+        error = "Bad yaml format. A full dynamic matrix requires [ [rows, cols], [... values ...] ]";
+        return false;
+    }
+    values = node;
+
+    // If one dimension is dynamic -> calculate
+    if (rows == Eigen::Dynamic)
+    {
+        if (values.size() % cols != 0)
+        {
+            error = "Input size of dynamic row matrix is not a multiple of fixed column size";
+            return false;
+        }
+        rows = values.size() / cols;
+    }
+    if (cols == Eigen::Dynamic)
+    {
+        if (values.size() % rows != 0)
+        {
+            error = "Input size of dynamic column matrix is not a multiple of fixed row size";
+            return false;
+        }
+        cols = values.size() / rows;
+    }
+
+    // final check for good size
+    if (values.size() != (std::size_t)rows * cols)
+    {
+        error = "Wrong input size";
+        return false;
+    }
+    return true;
+}
+
+/** \brief Check that a YAML node can be decoded as a matrix without allocating it.
+ *
+ * @param rows, cols fixed sizes or Eigen::Dynamic
+ */
+template <typename _Scalar>
+bool checkMatrix(const YAML::Node& node, int rows, int cols)
+{
+    YAML::Node  values;
+    std::string error;
+    if (not matrixValues(node, rows, cols, values, error)) return false;
+
+    _Scalar value;
+    for (auto it = values.begin(); it != values.end(); ++it)
+        if (not decodeScalar(*it, value)) return false;
+
+    return true;
+}
+
+/** \brief Compare two YAML matrices entry by entry without allocating them.
+ *
+ * @param rows, cols fixed sizes or Eigen::Dynamic
+ * @return if both are valid matrices of the same size and all entries differ less than tolerance
+ */
+template <typename _Scalar>
+bool compareMatrix(const YAML::Node& node1, const YAML::Node& node2, int rows, int cols, double tolerance)
+{
+    YAML::Node  values1, values2;
+    int         rows1 = rows, cols1 = cols, rows2 = rows, cols2 = cols;
+    std::string error;
+    if (not matrixValues(node1, rows1, cols1, values1, error) or
+        not matrixValues(node2, rows2, cols2, values2, error) or rows1 != rows2 or cols1 != cols2)
+        return false;
+
+    _Scalar value1, value2;
+    for (auto it1 = values1.begin(), it2 = values2.begin(); it1 != values1.end(); ++it1, ++it2)
+    {
+        if (not decodeScalar(*it1, value1) or not decodeScalar(*it2, value2) or
+            not(std::abs((double)value1 - (double)value2) < tolerance))
+            return false;
+    }
+    return true;
+}
+
+/** \brief Decode the entries of a YAML sequence (row by row) into an already sized matrix.
+ *
+ * The sequence is iterated once and each entry is written directly into the matrix storage.
+ * Returns false if any entry cannot be converted.
+ */
+template <typename _Scalar, int _Rows, int _Cols, int _Options, int _MaxRows, int _MaxCols>
+bool decodeMatrixValues(const YAML::Node&                                                       values,
+                        Eigen::Matrix<_Scalar, _Rows, _Cols, _Options, _MaxRows, _MaxCols>& matrix)
+{
+    _Scalar*           data = matrix.data();
+    const Eigen::Index rows = matrix.rows();
+    const Eigen::Index cols = matrix.cols();
+
+    Eigen::Index i = 0, j = 0;
+    for (auto it = values.begin(); it != values.end(); ++it)
+    {
+        if (i >= rows) return false;
+
+        auto index = (_Options & Eigen::RowMajor) ? i * cols + j : j * rows + i;
+        if (not decodeScalar(*it, data[index])) return false;
+
+        if (++j == cols)
+        {
+            j = 0;
+            ++i;
+        }
+    }
+    return i == rows;
+}
+}  // namespace conversion
+}  // namespace yaml_schema_cpp
 
 namespace YAML
 {
@@ -26,16 +357,7 @@ struct convert<Eigen::Matrix<_Scalar, _Rows, _Cols, _Options, _MaxRows, _MaxCols
      */
     static Node encode(const Eigen::Matrix<_Scalar, _Rows, _Cols, _Options, _MaxRows, _MaxCols>& matrix)
     {
-        Node node;  //(NodeType::Sequence);
-
-        int nValues = matrix.rows() * matrix.cols();
-
-        for (int i = 0; i < nValues; ++i)
-        {
-            node.push_back(matrix(i / matrix.cols(), i % matrix.cols()));
-        }
-
-        return node;
+        return yaml_schema_cpp::conversion::encodeMatrix(matrix);
     }
 
     /** \brief Decode a YAML sequence into a ````Eigen::Matrix<typename _Scalar, int _Rows, int _Cols>````
@@ -55,123 +377,23 @@ struct convert<Eigen::Matrix<_Scalar, _Rows, _Cols, _Options, _MaxRows, _MaxCols
      */
     static bool decode(const Node& node, Eigen::Matrix<_Scalar, _Rows, _Cols, _Options, _MaxRows, _MaxCols>& matrix)
     {
-        YAML::Node values;
+        YAML::Node  values;
+        int         rows = _Rows, cols = _Cols;
+        std::string error;
 
-        // ==========================================================================================
-        // Special case empty vector/matrix
-        if (node.IsSequence() and node.size() == 0)
-        {
-            if (_Rows != Eigen::Dynamic and _Cols != Eigen::Dynamic)
-            {
-                std::cout << "Empty input sequence with not dynamic matrix" << std::endl;
-                return false;
-            }
-        }
-        // sizes given by YAML
-        else if (node[0].Type() == NodeType::Sequence)
-        {
-            if (node.size() == 2 && node[0].size() == 2 && node[1].Type() == NodeType::Sequence &&
-                node[1].size() ==
-                    node[0][0].as<unsigned int>() * node[0][1].as<unsigned int>())  // YAML string is well formed
-            {
-                int rows = node[0][0].as<int>();
-                int cols = node[0][1].as<int>();
-                values   = node[1];
-                // full dynamic
-                if (_Rows == Eigen::Dynamic && _Cols == Eigen::Dynamic)
-                {
-                    matrix.resize(rows, cols);
-                }
-                // only rows dynamic
-                else if (_Rows == Eigen::Dynamic)
-                {
-                    if (_Cols != cols)
-                    {
-                        std::cout << "Wrong number of cols" << std::endl;
-                        return false;
-                    }
-                    matrix.resize(rows, Eigen::NoChange);
-                }
-                // only cols dynamic
-                else if (_Cols == Eigen::Dynamic)
-                {
-                    if (_Rows != rows)
-                    {
-                        std::cout << "Wrong number of rows" << std::endl;
-                        return false;
-                    }
-                    matrix.resize(Eigen::NoChange, cols);
-                }
-                else  // fixed size
-                {
-                    if (_Rows != rows || _Cols != cols)
-                    {
-                        std::cout << "Wrong size" << std::endl;
-                        return false;
-                    }
-                }
-            }
-            else
-            {
-                std::cout << "Bad matrix specification" << std::endl;
-                return false;
-            }
-        }
-        // sizes deduced
-        else
+        if (not yaml_schema_cpp::conversion::matrixValues(node, rows, cols, values, error))
         {
-            // If full dynamic -> error
-            if (_Rows == Eigen::Dynamic && _Cols == Eigen::Dynamic)
-            {
-                std::cout << "Bad yaml format. A full dynamic matrix requires [ [rows, cols], [... values ...] ]"
-                          << std::endl;
-                return false;
-            }
-            values = node;
-
-            // If one dimension is dynamic -> calculate and resize
-
-            // _Rows is Dynamic
-            if (_Rows == Eigen::Dynamic)
-            {
-                if (values.size() % _Cols != 0)
-                {
-                    std::cout << "Input size of dynamic row matrix is not a multiple of fixed column size"
-                              << std::endl;
-                    return false;
-                }
-
-                int nDynRows = values.size() / _Cols;
-                matrix.resize(nDynRows, Eigen::NoChange);
-            }
-
-            // _Cols is Dynamic
-            if (_Cols == Eigen::Dynamic)
-            {
-                if (values.size() % _Rows != 0)
-                {
-                    std::cout << "Input size of dynamic column matrix is not a multiple of fixed row size"
-                              << std::endl;
-                    return false;
-                }
-
-                int nDynCols = values.size() / _Rows;
-                matrix.resize(Eigen::NoChange, nDynCols);
-            }
+            std::cout << error << std::endl;
+            return false;
         }
 
-        // final check for good size
-        if (values.size() != (unsigned int)(matrix.rows() * matrix.cols()))
+        // Fill the matrix
+        matrix.resize(rows, cols);
+        if (not yaml_schema_cpp::conversion::decodeMatrixValues(values, matrix))
         {
-            std::cout << "Wrong input size" << std::endl;
+            std::cout << "Wrong input value" << std::endl;
             return false;
         }
-        else  // Fill the matrix
-        {
-            for (int i = 0; i < matrix.rows(); i++)
-                for (int j = 0; j < matrix.cols(); j++)
-                    matrix(i, j) = values[(int)(i * matrix.cols() + j)].as<_Scalar>();
-        }
         return true;
     }
 };
@@ -209,10 +431,13 @@ struct convert<Eigen::Quaternion<_Scalar, _Options> >
         }
         else
         {
-            quaternion.x() = node[0].as<_Scalar>();
-            quaternion.y() = node[1].as<_Scalar>();
-            quaternion.z() = node[2].as<_Scalar>();
-            quaternion.w() = node[3].as<_Scalar>();
+            Eigen::Matrix<_Scalar, 4, 1> coeffs;
+            if (not yaml_schema_cpp::conversion::decodeMatrixValues(node, coeffs))
+            {
+                std::cout << "Wrong quaternion input value!" << std::endl;
+                return false;
+            }
+            quaternion.coeffs() = coeffs;  // x-y-z-w
         }
         return true;
     }
@@ -228,16 +453,7 @@ struct convert<Eigen::CwiseNullaryOp<A1, A2> >
 {
     static Node encode(const Eigen::CwiseNullaryOp<A1, A2>& matrix)
     {
-        Node node;
-
-        int nValues = matrix.rows() * matrix.cols();
-
-        for (int i = 0; i < nValues; ++i)
-        {
-            node.push_back(matrix(i / matrix.cols(), i % matrix.cols()));
-        }
-
-        return node;
+        return yaml_schema_cpp::conversion::encodeMatrix(matrix);
     }
 };
 
@@ -251,16 +467,7 @@ struct convert<Eigen::CwiseBinaryOp<A1, A2, A3> >
 {
     static Node encode(const Eigen::CwiseBinaryOp<A1, A2, A3>& matrix)
     {
-        Node node;
-
-        int nValues = matrix.rows() * matrix.cols();
-
-        for (int i = 0; i < nValues; ++i)
-        {
-            node.push_back(matrix(i / matrix.cols(), i % matrix.cols()));
-        }
-
-        return node;
+        return yaml_schema_cpp::conversion::encodeMatrix(matrix);
     }
 };
 
@@ -274,16 +481,7 @@ struct convert<Eigen::CwiseUnaryOp<A1, A2> >
 {
     static Node encode(const Eigen::CwiseUnaryOp<A1, A2>& matrix)
     {
-        Node node;
-
-        int nValues = matrix.rows() * matrix.cols();
-
-        for (int i = 0; i < nValues; ++i)
-        {
-            node.push_back(matrix(i / matrix.cols(), i % matrix.cols()));
-        }
-
-        return node;
+        return yaml_schema_cpp::conversion::encodeMatrix(matrix);
     }
 };
 
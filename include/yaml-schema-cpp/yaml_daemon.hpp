@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Write a framed message in a stream socket: length (4 bytes, big endian) followed by the message
+ * @return false if the connection was closed or failed
+ */
+bool writeMessage(int fd, const std::string& message);
+
+/**
+ * @brief Read a framed message from a stream socket (see writeMessage())
+ * @return false if the connection was closed or failed
+ */
+bool readMessage(int fd, std::string& message);
+
+/**
+ * @brief Local daemon that validates inputs, generates templates and diffs inputs for clients connected to a Unix
+ * domain socket, keeping the schema cache warm between requests (see getCompiledSchema()).
+ * Each message is a YAML map (framed, see writeMessage()). Requests ('command' and its parameters):
+ *   validate: schema, input (path)      --> valid, log, node (completed with DEFAULT and VALUE)
+ *   generate: schema                    --> template (see generateTemplate())
+ *   diff:     schema, old, new (paths)  --> diff (sequence of maps with type, path, old and new, see diffNodes())
+ *   stop:                               --> stops the daemon
+ * All responses contain 'ok' and, if false, 'error'. Paths of inputs should be absolute.
+ * Each connection is served by its own thread and can send any number of requests.
+ */
+class YamlDaemon
+{
+  public:
+    YamlDaemon(const std::vector<std::string>& folders_schema, const std::string& socket_path, bool override = true);
+
+    /**
+     * @brief Serve requests until stop() is called or a 'stop' request is received.
+     * Throws std::runtime_error if the socket cannot be created, or if socket_path already exists and it is not a
+     * socket left by a daemon that did not stop (then it is replaced).
+     */
+    void run();
+
+    void stop();
+
+    /**
+     * @brief Response to a request (as received through the socket)
+     */
+    YAML::Node handleRequest(const YAML::Node& request);
+
+  private:
+    void serve(int client_fd);
+
+    std::vector<std::string> folders_schema_;
+    std::string              socket_path_;
+    bool                     override_;
+
+    std::atomic<bool>            running_;
+    std::mutex                   clients_mutex_;
+    std::set<int>                client_fds_;
+    std::vector<std::thread>     client_threads_;
+    std::vector<std::thread::id> finished_threads_;  // to be joined
+};
+
+/**
+ * @brief Send a request to a YamlDaemon and wait for its response (see YamlDaemon)
+ * Throws std::runtime_error if the daemon cannot be reached or the connection is closed.
+ */
+YAML::Node requestDaemon(const std::string& socket_path, const YAML::Node& request);
+
+}  // namespace yaml_schema_cpp
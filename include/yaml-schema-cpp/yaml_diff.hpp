@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+#include "yaml-schema-cpp/yaml_hash.hpp"
+
+namespace yaml_schema_cpp
+{
+enum class DiffType
+{
+    ADDED,
+    REMOVED,
+    CHANGED
+};
+
+/**
+ * @brief A difference between two YAML documents
+ */
+struct DiffEntry
+{
+    DiffType    diff_type;
+    std::string path;       // same format as the log: "map/field", "sequence[2]/field"
+    std::string type;       // type specified in the schema (empty if not specified)
+    YAML::Node  old_value;  // undefined if ADDED
+    YAML::Node  new_value;  // undefined if REMOVED
+};
+
+std::string toString(DiffType diff_type);
+
+/**
+ * @brief Differences between two YAML documents following a schema.
+ * Both documents are walked once, skipping identical subtrees using structural hashes (see NodeHasher).
+ * Fields of custom types are compared field by field. Fields of trivial types, derived types and
+ * sequences of different size are reported as a whole. Fields not specified in the schema are
+ * compared interpreting scalars automatically (see compareNodesAutoType()).
+ *
+ * @param node_old, node_new documents to be compared (usually already validated with applySchema())
+ * @param name_schema schema of both documents
+ * @param folders_schema string vector containing folders where to search for schema files
+ * @return list of added, removed and changed paths (throws if the schema could not be loaded)
+ */
+std::vector<DiffEntry> diffNodes(const YAML::Node&               node_old,
+                                 const YAML::Node&               node_new,
+                                 const std::string&              name_schema,
+                                 const std::vector<std::string>& folders_schema,
+                                 bool                            override = true);
+
+/**
+ * @brief Differences between two YAML documents interpreting all scalars automatically (no schema)
+ */
+std::vector<DiffEntry> diffNodesAutoType(const YAML::Node& node_old, const YAML::Node& node_new);
+
+void diffNodesSchema(const YAML::Node&               node_old,
+                     const YAML::Node&               node_new,
+                     const YAML::Node&               node_schema,
+                     const std::vector<std::string>& folders_schema,
+                     const std::string&              path,
+                     NodeHasher&                     hasher,
+                     std::vector<DiffEntry>&         diffs);
+
+void diffNodesType(const YAML::Node&               node_old,
+                   const YAML::Node&               node_new,
+                   const std::string&              type,
+                   const std::vector<std::string>& folders_schema,
+                   const std::string&              path,
+                   NodeHasher&                     hasher,
+                   std::vector<DiffEntry>&         diffs);
+
+void diffNodesAutoType(const YAML::Node&       node_old,
+                       const YAML::Node&       node_new,
+                       const std::string&      path,
+                       NodeHasher&             hasher,
+                       std::vector<DiffEntry>& diffs);
+
+}  // namespace yaml_schema_cpp
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <ostream>
+#include <sstream>
+
 #include "yaml-cpp/yaml.h"
 
 namespace yaml_schema_cpp
@@ -8,16 +11,60 @@ const std::string red("\033[0;31m");
 const std::string yellow("\033[1;33m");
 const std::string reset("\033[0m");
 
+/**
+ * @brief Write the template YAML of a schema in a new file (a suffix is added to the name if the file exists)
+ * @return the path of the file created
+ */
 std::string generateTemplate(std::string                     filepath,
                              const std::string&              name_schema,
                              const std::vector<std::string>& folders_schema,
                              bool                            override = true);
 
+/**
+ * @brief Write the template YAML of a schema in a stream, directly with a YAML::Emitter (see schemaToTemplate()).
+ * Throws std::runtime_error if the schema (or the schema of any of its types) cannot be loaded.
+ */
+void generateTemplate(std::ostream&                   output,
+                      const std::string&              name_schema,
+                      const std::vector<std::string>& folders_schema,
+                      bool                            override = true);
+
+/**
+ * @brief Write the templates of all schemas found in the schema folders (see getAllSchemas()) in a folder, named
+ * '<schema_name>_template.yaml' (existing files are overwritten).
+ * The templates are generated in parallel, sharing the schema cache (each schema is loaded only once).
+ *
+ * @param n_threads maximum number of templates generated at the same time
+ * @return if all templates were generated (errors written in log)
+ */
+bool generateTemplates(const std::string&              output_folder,
+                       const std::vector<std::string>& folders_schema,
+                       std::stringstream&              log,
+                       bool                            override  = true,
+                       unsigned int                    n_threads = 4);
+
 YAML::Node generateYaml(std::string schema_file, const std::vector<std::string>& folders_schema, bool override = true);
 
+/**
+ * @brief Generate the template YAML of a schema node
+ * @param depth array dimensions of the type already handled (node_output is an element of the field at this depth)
+ */
 void schemaToYaml(const YAML::Node&               node_schema,
                   YAML::Node&                     node_output,
                   const std::vector<std::string>& folders_schema,
-                  bool                            override = true);
+                  bool                            override = true,
+                  size_t                          depth    = 0);
+
+/**
+ * @brief Emit the template YAML of a schema node: the value of each field (default, first option or zero) followed
+ * by a comment with its documentation. Fields with VALUE are not emitted.
+ * The schemas of the custom types are taken from the schema cache (see getCompiledSchema()).
+ * @param depth array dimensions of the type already handled (see schemaToYaml())
+ */
+void schemaToTemplate(const YAML::Node&               node_schema,
+                      YAML::Emitter&                  emitter,
+                      const std::vector<std::string>& folders_schema,
+                      bool                            override = true,
+                      size_t                          depth    = 0);
 
 }  // namespace yaml_schema_cpp
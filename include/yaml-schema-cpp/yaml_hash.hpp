@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Identity of the yaml-cpp node (not of its contents).
+ * Two YAML::Node objects referring to the same node have the same identity.
+ * NOTE: The identity is only valid while the node memory is alive.
+ */
+const void* nodeIdentity(const YAML::Node& node);
+
+/**
+ * @brief Index the children of a map node by their keys (first one if duplicated keys)
+ * @return empty index if the node is not a map
+ */
+std::unordered_map<std::string, YAML::Node> indexMapNode(const YAML::Node& node);
+
+/**
+ * @brief Structural hash and equality of YAML subtrees, interpreting all scalars automatically
+ * (as compareNodesAutoType()).
+ *
+ * Numbers are hashed by value (1e3, 1000 and 1000.0 have the same hash) and maps are hashed
+ * independently of the order of their keys, so equal nodes always have the same hash.
+ * Alternatively, identical() compares scalars exactly by their text (for scalars of known type, e.g. strings).
+ * The hashes of all subtrees are computed bottom-up once and cached by node identity (the hashed
+ * nodes are kept alive by the hasher): it should not be used after modifying the nodes.
+ */
+class NodeHasher
+{
+  public:
+    std::size_t hash(const YAML::Node& node);
+
+    /**
+     * @brief Compare two nodes, short-circuiting on hash mismatch
+     * @return if both nodes are equal (see compareNodesAutoType())
+     */
+    bool equal(const YAML::Node& node1, const YAML::Node& node2);
+
+    /**
+     * @brief Compare two nodes with scalars as text ("007" and "7" are different), short-circuiting on hash mismatch
+     * @return if both nodes are identical (identical nodes are also equal)
+     */
+    bool identical(const YAML::Node& node1, const YAML::Node& node2);
+
+  private:
+    std::size_t hash(const YAML::Node& node, bool exact);
+    std::size_t hashRecursive(const YAML::Node& node, bool exact);
+    bool        equalRecursive(const YAML::Node& node1, const YAML::Node& node2, bool exact);
+
+    std::unordered_map<const void*, std::size_t> hashes_;
+    std::unordered_map<const void*, std::size_t> exact_hashes_;
+    std::vector<YAML::Node>                      pinned_;  // roots of the hashed nodes (keeps identities valid)
+};
+
+/**
+ * @brief Compare two scalar nodes interpreting them automatically.
+ * First try as integers, second as doubles, finally as strings.
+ */
+bool equalScalarsAutoType(const YAML::Node& node1, const YAML::Node& node2);
+
+/**
+ * @brief Hash of a scalar node consistent with equalScalarsAutoType()
+ */
+std::size_t hashScalarAutoType(const YAML::Node& node);
+
+}  // namespace yaml_schema_cpp
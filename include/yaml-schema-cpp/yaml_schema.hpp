@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "yaml-cpp/yaml.h"
+#include "yaml-schema-cpp/yaml_binder.hpp"
 #include "yaml-schema-cpp/yaml_conversion.hpp"
 #include "yaml-schema-cpp/type_check.hpp"
 #include "yaml-schema-cpp/yaml_utils.hpp"
@@ -24,10 +25,22 @@ static std::string            BASE             = SCHEMA_PREFIX + "base";
 static std::list<std::string> RESERVED_KEYS{TYPE, MANDATORY, DOC, OPTIONS, DEFAULT, BASE};
 static std::list<std::string> REQUIRED_KEYS{TYPE, MANDATORY, DOC};
 
+struct CompiledSchema;
+
 YAML::Node loadSchema(std::string                     schema_file,
                       const std::vector<std::string>& folders_schema,
                       std::stringstream&              log,
                       bool                            override = true);
+YAML::Node loadSchemaFile(const std::string&              path_schema,
+                          const std::vector<std::string>& folders_schema,
+                          std::stringstream&              log,
+                          bool                            override = true);
+// Same as loadSchemaFile(), also reporting the files loaded (the schema file and the followed ones)
+YAML::Node loadSchemaFile(const std::string&              path_schema,
+                          const std::vector<std::string>& folders_schema,
+                          std::stringstream&              log,
+                          bool                            override,
+                          std::vector<LoadedFile>&        loaded_files);
 void       checkSchema(const YAML::Node&               node_schema,
                        const std::string&              field,
                        const YAML::Node&               node_schema_parent,
@@ -45,35 +58,115 @@ void       checkSchemaOptions(const YAML::Node&               node_schema,
                               const YAML::Node&               node_schema_parent,
                               const std::vector<std::string>& folders_schema);
 
+// Same checks using the already resolved schema of the type (see resolveTypeSchema())
+void checkSchemaValue(const YAML::Node&               node_schema,
+                      const std::string&              node_field,
+                      const YAML::Node&               node_schema_parent,
+                      const YAML::Node&               node_schema_type,
+                      const std::vector<std::string>& folders_schema);
+void checkSchemaDefault(const YAML::Node&               node_schema,
+                        const std::string&              node_field,
+                        const YAML::Node&               node_schema_parent,
+                        const YAML::Node&               node_schema_type,
+                        const std::vector<std::string>& folders_schema);
+void checkSchemaOptions(const YAML::Node&               node_schema,
+                        const std::string&              node_field,
+                        const YAML::Node&               node_schema_parent,
+                        const YAML::Node&               node_schema_type,
+                        const std::vector<std::string>& folders_schema);
+
 bool validateAllSchemas(const std::vector<std::string>& folders_schema, bool verbose, bool override = true);
 
+/**
+ * @brief Validate node_input against the schema, completing it with DEFAULT and VALUE of missing fields.
+ *
+ * @param binder if provided, the bound fields are assigned during the validation (see SchemaBinder)
+ * @return if node_input is valid (errors written in log)
+ */
 bool applySchema(YAML::Node&                     node_input,
                  const std::string&              name_schema,
                  const std::vector<std::string>& folders,
                  std::stringstream&              log,
                  const std::string&              acc_field,
-                 bool                            override = true);
+                 bool                            override = true,
+                 const SchemaBinder*             binder   = nullptr);
+
+/**
+ * @brief Resolve the schema of the lowest element type of 'type' (example: for MyType[3][] loads MyType schema)
+ * The schema is taken from the schema cache (see getCompiledSchema()).
+ *
+ * @param node_schema_type OUTPUT the compiled schema, should not be modified (undefined if 'type' is trivial)
+ * @returns false if the type is not trivial and its schema could not be loaded (error written in log)
+ */
+bool resolveTypeSchema(const std::string&              type,
+                       const std::vector<std::string>& folders,
+                       YAML::Node&                     node_schema_type,
+                       std::stringstream&              log,
+                       bool                            override = true);
+
+/**
+ * @brief Same as resolveTypeSchema(), also getting the compiled schema (nullptr if 'type' is trivial)
+ */
+bool resolveTypeSchema(const std::string&                     type,
+                       const std::vector<std::string>&        folders,
+                       YAML::Node&                            node_schema_type,
+                       std::shared_ptr<const CompiledSchema>& compiled_schema_type,
+                       std::stringstream&                     log,
+                       bool                                   override = true);
+
+/**
+ * @brief Same as applySchema() but using an already resolved schema of the type (see resolveTypeSchema()).
+ * If node_schema_type is undefined and the type is not trivial, the schema is loaded.
+ *
+ * @param compiled_schema_type compiled schema of node_schema_type, if any (its normalized OPTIONS are used)
+ */
+bool applySchemaResolved(YAML::Node&                     node_input,
+                         const std::string&              type,
+                         const YAML::Node&               node_schema_type,
+                         const std::vector<std::string>& folders,
+                         std::stringstream&              log,
+                         const std::string&              acc_field,
+                         bool                            override,
+                         const SchemaBinder*             binder               = nullptr,
+                         const CompiledSchema*           compiled_schema_type = nullptr);
 
+/**
+ * @param compiled_schema compiled schema that node_schema belongs to, if any (its normalized OPTIONS are used,
+ * otherwise the options are compared one by one)
+ */
 bool applySchemaRecursive(YAML::Node&                     node_input,
                           YAML::Node&                     node_input_parent,
                           const YAML::Node&               node_schema,
                           const std::vector<std::string>& folders,
                           std::stringstream&              log,
                           const std::string&              acc_field,
-                          bool                            override);
+                          bool                            override,
+                          const SchemaBinder*             binder          = nullptr,
+                          const CompiledSchema*           compiled_schema = nullptr);
 
+/**
+ * @brief Validate node_input against a specification of derived type
+ * @param depth array dimensions of the type already handled (node_input is an element of the field at this depth)
+ */
 bool applySchemaDerived(YAML::Node&                     node_input,
                         YAML::Node&                     node_input_parent,
                         const YAML::Node&               node_schema,
                         const std::vector<std::string>& folders,
                         std::stringstream&              log,
                         const std::string&              acc_field,
-                        bool                            override);
+                        bool                            override,
+                        const SchemaBinder*             binder = nullptr,
+                        size_t                          depth  = 0);
 
 bool isInOptions(const YAML::Node&               input_node,
                  const YAML::Node&               options_node,
                  const std::string&              type,
                  const std::vector<std::string>& folders_schema = {});
+bool isInOptionsResolved(const YAML::Node&               input_node,
+                         const YAML::Node&               options_node,
+                         const std::string&              type,
+                         const YAML::Node&               node_schema_type,
+                         const std::vector<std::string>& folders_schema);
 
 bool hasAnyReservedKey(const YAML::Node& node_schema);
 bool isSpecification(const YAML::Node& node_schema);
@@ -2,19 +2,45 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include "yaml-cpp/yaml.h"
+#include "yaml-schema-cpp/yaml_binder.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
 
 namespace yaml_schema_cpp
 {
 
+/**
+ * @brief Loads and validates a YAML input file (or node) against schemas.
+ * Thread safe: any number of threads can call the const methods (readers) while another thread calls the others
+ * (writers). Readers get a snapshot of the state and do not block each other nor wait for a running applySchema()
+ * or loadYaml(), writers are serialized.
+ */
 class YamlServer
 {
   public:
     YamlServer(bool override = true);
     YamlServer(const std::vector<std::string>& folders_schema, bool override = true);
     YamlServer(const std::vector<std::string>& folders_schema, const std::string& path_input, bool override = true);
+    YamlServer(YamlServer&& other);
 
     bool applySchema(const std::string& name_schema);
+    bool applySchema(const std::string& name_schema, const SchemaBinder& binder);  // fills bound variables
+
+    /**
+     * @brief Same as loadYaml() and applySchema(), using the validation cache if set (see setValidationCache()).
+     * If the cache has the result for the same input, followed files and schema files (see validationFingerprint()),
+     * the validated node and the log are loaded from the cache without flattening nor validating the input.
+     */
+    bool loadAndApplySchema(const std::string& path_input, const std::string& name_schema);
+
+    /**
+     * @brief Set the folder of the persistent validation cache used by loadAndApplySchema() (empty: no cache).
+     * The folder can be shared by several processes.
+     */
+    void        setValidationCache(const std::string& cache_folder);
+    std::string getValidationCache() const;
 
     void                     addFolderSchema(const std::vector<std::string>& folders_schema, bool before = false);
     void                     addFolderSchema(const std::string& folder_schema, bool before = false);
@@ -28,13 +54,29 @@ class YamlServer
     YAML::Node getNode() const;
 
   private:
-    std::vector<std::string> folders_schema_;
+    // state published by writers, never modified after being published
+    struct State
+    {
+        std::vector<std::string> folders_schema;
+        std::string              path_input;
+        YAML::Node               node_input;
+        std::string              log;
+        std::string              cache_folder;
+    };
+
+    bool applySchema(const std::string& name_schema, const SchemaBinder* binder);
+
+    // modify a copy of the state (writers)
+    void load(State& state, const std::string& path_input, std::vector<LoadedFile>& loaded_files) const;
+    bool validate(State& state, const std::string& name_schema, const SchemaBinder* binder) const;
 
-    std::string path_input_;
+    std::shared_ptr<const State> getState() const;
+    void                         setState(const std::shared_ptr<const State>& state);
 
-    std::stringstream log_;
+    std::shared_ptr<const State> state_;
 
-    YAML::Node node_input_;
+    mutable std::mutex state_mutex_;  // only held to copy or replace state_
+    std::mutex         write_mutex_;  // serializes writers
 
     bool override_;
 };
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+namespace yaml_schema_cpp
+{
+/**
+ * @brief Validate a YAML file against a schema while it is parsed, without building the whole document tree.
+ * The parser events (see YAML::EventHandler) are checked against the compiled schema as they arrive: maps of the
+ * schema are walked without being stored and each field is materialized only while it is validated (the elements
+ * of arrays of fields without VALUE or OPTIONS one by one), so the memory is bounded by the largest field.
+ * The result and the errors in log are the same as loading the file (see YamlServer::loadYaml()) and calling
+ * applySchema(), although some errors may be written in a different order.
+ * Documents with 'follow', repeated keys, complex keys or aliases to streamed maps are validated loading the
+ * whole document.
+ *
+ * @param node_output OUTPUT the fields in 'keep' (completed with DEFAULT and VALUE), in their place in the document
+ * @param keep paths of the fields to be materialized in node_output (same format as the log: "map1/param1")
+ * @return if the file is valid (errors written in log). Throws if the file cannot be read or parsed.
+ */
+bool applySchemaStream(const std::string&              path_input,
+                       const std::string&              name_schema,
+                       const std::vector<std::string>& folders_schema,
+                       std::stringstream&              log,
+                       YAML::Node&                     node_output,
+                       const std::vector<std::string>& keep     = {},
+                       bool                            override = true);
+
+/**
+ * @brief Same as above reading the document from a stream.
+ * @param current_folder folder of the document, to resolve relative paths (empty: relative paths not modified)
+ * If the document has to be loaded entirely (see above), the stream has to be seekable (throws otherwise).
+ */
+bool applySchemaStream(std::istream&                   input,
+                       const std::string&              current_folder,
+                       const std::string&              name_schema,
+                       const std::vector<std::string>& folders_schema,
+                       std::stringstream&              log,
+                       YAML::Node&                     node_output,
+                       const std::vector<std::string>& keep     = {},
+                       bool                            override = true);
+
+}  // namespace yaml_schema_cpp
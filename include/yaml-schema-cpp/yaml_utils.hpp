@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <future>
 #include <list>
 #include <iostream>
 #include "yaml-cpp/yaml.h"
@@ -12,29 +15,54 @@ namespace yaml_schema_cpp
 // 'folders'
 // -> input node (is_schema = false): path to file allowed (either relative or absolute). Relative paths will be done
 // with respect to the first item specified in folders. No search will be performed.
+// 'parallel': the files followed from the same map are loaded and flattened concurrently (one thread each, only if
+// there are at least two), and then merged in their original order, so the result is the same as sequentially.
 void flattenNode(YAML::Node&              node,
                  std::string              current_folder,
                  std::vector<std::string> schema_folders,
                  bool                     is_schema,
-                 bool                     override);
+                 bool                     override,
+                 bool                     parallel = false);
+
+/**
+ * @brief File loaded (see loadFile()), e.g. a followed file while flattening
+ */
+struct LoadedFile
+{
+    std::string path;        // normalized
+    long long   write_time;  // just before loading it (see lastWriteTime())
+    std::string hash;        // of the contents parsed (see hashContents())
+};
+
+// Same as flattenNode(), also reporting the files loaded (each followed file, once)
+void flattenNode(YAML::Node&              node,
+                 std::string              current_folder,
+                 std::vector<std::string> schema_folders,
+                 bool                     is_schema,
+                 bool                     override,
+                 bool                     parallel,
+                 std::vector<LoadedFile>& loaded_files);
 
 void flattenMap(YAML::Node&              node,
                 std::string              current_folder,
                 std::vector<std::string> schema_folders,
                 bool                     is_schema,
-                bool                     override);
+                bool                     override,
+                bool                     parallel = false);
 
 void flattenSequence(YAML::Node&              node,
                      std::string              current_folder,
                      std::vector<std::string> schema_folders,
                      bool                     is_schema,
-                     bool                     override);
+                     bool                     override,
+                     bool                     parallel = false);
 
 void insertNodes(YAML::Node&              node,
                  const YAML::Node&        node_follow,
                  std::string              current_folder,
                  std::vector<std::string> schema_folders,
-                 bool                     override);
+                 bool                     override,
+                 bool                     parallel = false);
 
 void writeErrorToLog(std::stringstream& log,
                      const std::string& _acc_field,
@@ -52,6 +80,27 @@ void addNodeYaml(YAML::Node&        node,
                  bool               override,
                  std::string        parent_path = "");
 
+/**
+ * @brief If the string starts with "./" or "../" (relative paths, see addNodeYaml()), checked without copies
+ */
+bool isRelativePathPrefix(const std::string& str);
+
+/**
+ * @brief Last modification time of a file (in the filesystem clock units), -1 if it does not exist
+ */
+long long lastWriteTime(const std::string& path);
+
+/**
+ * @brief Hash of the contents of a file (FNV-1a, hexadecimal)
+ */
+std::string hashContents(const std::string& contents);
+
+/**
+ * @brief Same as YAML::LoadFile(), also reporting the file loaded. The hash is the one of the contents actually
+ * parsed, so a change of the file while (or after) loading it is detected by comparing hashes.
+ */
+YAML::Node loadFile(const std::string& path, LoadedFile& loaded_file);
+
 std::string findFileRecursive(const std::string& name_with_extension, const std::vector<std::string>& folders);
 
 std::string findSchema(std::string                     name_schema,
@@ -60,6 +109,13 @@ std::string findSchema(std::string                     name_schema,
 
 std::vector<std::string> getAllSchemas(const std::vector<std::string>& root_folders);
 
+/**
+ * @brief Parse the schema folders argument of the command line tools: a path or '[path1 path2 ...]'.
+ * Relative paths are made absolute from current_path and '~' is replaced by $HOME
+ * (throws std::runtime_error if HOME is not defined).
+ */
+std::vector<std::string> parseFoldersArgument(std::string folders_argument, const std::string& current_path);
+
 std::list<YAML::Node> findNodesWithKey(const YAML::Node root_node, const std::string& key);
 
 std::string sequenceToString(const YAML::Node& node);
@@ -96,6 +152,11 @@ bool isDerivedType(const std::string& type_str);
  */
 std::string getLowerElementType(const std::string type_str);
 
+/**
+ * @brief get the element type 'depth' levels lower (example: for double[3][5][2] and depth 2 returns double[2])
+ */
+std::string getLowerElementType(const std::string& type_str, size_t depth);
+
 /**
  * @brief get the lowest elements type (example: for double[3][5] returns double)
  * @param type_str INPUT string containing type
@@ -127,39 +188,11 @@ std::string getCheckType(const YAML::Node& node);
         }                                                                                                             \
     }
 
-#if _EIGEN_FOUND == 1
-#define COMPARE_EIGEN(size)                                                                                           \
-    if (type == "Vector" #size "d" or type == "Eigen::Vector" #size "d")                                              \
-    {                                                                                                                 \
-        try                                                                                                           \
-        {                                                                                                             \
-            return (node1.as<Eigen::Matrix<double, size, 1> >() - node2.as<Eigen::Matrix<double, size, 1> >())        \
-                       .cwiseAbs()                                                                                    \
-                       .maxCoeff() < 1e-9;                                                                            \
-        }                                                                                                             \
-        catch (const std::exception& e)                                                                               \
-        {                                                                                                             \
-            return false;                                                                                             \
-        }                                                                                                             \
-    }                                                                                                                 \
-    if (type == "Matrix" #size "d" or type == "Eigen::Matrix" #size "d")                                              \
-    {                                                                                                                 \
-        try                                                                                                           \
-        {                                                                                                             \
-            return (node1.as<Eigen::Matrix<double, size, size> >() - node2.as<Eigen::Matrix<double, size, size> >())  \
-                       .cwiseAbs()                                                                                    \
-                       .maxCoeff() < 1e-9;                                                                            \
-        }                                                                                                             \
-        catch (const std::exception& e)                                                                               \
-        {                                                                                                             \
-            return false;                                                                                             \
-        }                                                                                                             \
-    }
-#endif
 
 /**
  * @brief Compare two nodes interpreting all scalars automatically.
  * First try as integers, second as doubles, finally as strings.
+ * Uses structural hashes to short-circuit different subtrees (see NodeHasher).
  *
  * @param node1, node2 nodes to be compared
  * @return if both nodes are equal
@@ -178,6 +211,22 @@ bool compare(const YAML::Node&               node1,
              const YAML::Node&               node2,
              const std::string&              type,
              const std::vector<std::string>& folders_schema);
+
+/**
+ * @brief Compare two nodes interpreted as a given type, using an already resolved schema for non-trivial types
+ *
+ * @param node1, node2 nodes to be compared
+ * @param type string containing the type
+ * @param node_schema_type schema of the lowest element type (undefined: trivial or not resolved, loaded if needed)
+ * @param folders_schema string vector containing folders where to search for schema files
+ * @return if both nodes are equal
+ */
+bool compareResolved(const YAML::Node&               node1,
+                     const YAML::Node&               node2,
+                     const std::string&              type,
+                     const YAML::Node&               node_schema_type,
+                     const std::vector<std::string>& folders_schema);
+
 /**
  * @brief Compare two nodes interpreted as a given type (trivial: no schema needed)
  *
@@ -186,6 +235,12 @@ bool compare(const YAML::Node&               node1,
  * @return if both nodes are equal
  */
 bool compareTrivial(const YAML::Node& node1, const YAML::Node& node2, const std::string& type);
+#if _EIGEN_FOUND == 1
+/**
+ * @brief Compare two nodes as Eigen matrices, entry by entry with tolerance (see conversion::compareMatrix())
+ */
+bool compareEigen(const YAML::Node& node1, const YAML::Node& node2, const EigenType& eigen_type);
+#endif
 
 /**
  * @brief Compare two nodes interpreted as a given type (nontrivial: schema needed)
@@ -212,6 +267,72 @@ bool compareNonTrivialSchema(const YAML::Node&               node1,
                              const YAML::Node&               node2,
                              const YAML::Node&               node_schema,
                              const std::vector<std::string>& folders_schema);
+/**
+ * @brief Canonical key of an integer type value
+ */
+#define CANONICAL_KEY_INTEGER(TypeName)                                                                               \
+    if (type == #TypeName)                                                                                            \
+    {                                                                                                                 \
+        key += "i" + std::to_string(node.as<TypeName>()) + ";";                                                       \
+        return true;                                                                                                  \
+    }
+
+/**
+ * @brief Canonical key of a real type value (exact hexadecimal representation, 0 == -0, NaN has no key)
+ */
+#define CANONICAL_KEY_REAL(TypeName)                                                                                  \
+    if (type == #TypeName)                                                                                            \
+    {                                                                                                                 \
+        double value = node.as<TypeName>();                                                                           \
+        if (std::isnan(value)) return false;                                                                          \
+        if (value == 0) value = 0;                                                                                    \
+        char buffer[64];                                                                                              \
+        std::snprintf(buffer, sizeof(buffer), "%a", value);                                                           \
+        key += "r" + std::string(buffer) + ";";                                                                       \
+        return true;                                                                                                  \
+    }
+
+/**
+ * @brief Append to 'key' the canonical key of a node interpreted as a given type.
+ * Two nodes have the same canonical key iff compare() returns true.
+ *
+ * @param node node to be normalized
+ * @param type string containing the type
+ * @param node_schema_type schema of the lowest element type (undefined: trivial or not resolved, resolved if needed)
+ * @param folders_schema string vector containing folders where to search for schema files
+ * @param key OUTPUT string where the canonical key is appended
+ * @return false if the node does not have an exact canonical key (not convertible or compared with tolerance)
+ */
+bool canonicalKey(const YAML::Node&               node,
+                  const std::string&              type,
+                  const YAML::Node&               node_schema_type,
+                  const std::vector<std::string>& folders_schema,
+                  std::string&                    key);
+bool canonicalKeyTrivial(const YAML::Node& node, const std::string& type, std::string& key);
+bool canonicalKeyNonTrivialSchema(const YAML::Node&               node,
+                                  const YAML::Node&               node_schema,
+                                  const std::vector<std::string>& folders_schema,
+                                  std::string&                    key);
+
+/**
+ * @brief Call fn(item) for all items, in parallel using at most n_threads threads (at least one).
+ * Exceptions thrown by fn are rethrown after all threads finished.
+ */
+template <typename Item, typename Function>
+void parallelForEach(const std::vector<Item>& items, unsigned int n_threads, Function fn)
+{
+    std::atomic<size_t>            next(0);
+    std::vector<std::future<void>> workers;
+    for (size_t i = 0; i < std::min<size_t>(std::max(n_threads, 1u), items.size()); i++)
+    {
+        workers.push_back(std::async(std::launch::async, [&]() {
+            for (auto j = next++; j < items.size(); j = next++) fn(items[j]);
+        }));
+    }
+    for (auto& worker : workers) worker.wait();
+    for (auto& worker : workers) worker.get();
+}
+
 /**
  * @brief Return string with zero value of given type
  * @param type string containing the type
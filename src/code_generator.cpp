@@ -0,0 +1,553 @@
+#include "yaml-schema-cpp/code_generator.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include "yaml-schema-cpp/expression.hpp"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/schema_cache.hpp"
+#include "yaml-schema-cpp/type_check.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+const std::set<std::string> CPP_KEYWORDS{
+    "alignas",   "alignof",  "and",          "asm",      "auto",      "bool",          "break",     "case",
+    "catch",     "char",     "class",        "const",    "constexpr", "const_cast",    "continue",  "decltype",
+    "default",   "delete",   "do",           "double",   "else",      "enum",          "explicit",  "export",
+    "extern",    "false",    "float",        "for",      "friend",    "goto",          "if",        "inline",
+    "int",       "long",     "mutable",      "namespace", "new",      "noexcept",      "not",       "nullptr",
+    "operator",  "or",       "private",      "protected", "public",   "register",      "return",    "short",
+    "signed",    "sizeof",   "static",       "struct",   "switch",    "template",      "this",      "throw",
+    "true",      "try",      "typedef",      "typeid",   "typename",  "union",         "unsigned",  "using",
+    "virtual",   "void",     "volatile",     "while",    "xor",       "static_assert", "thread_local"};
+
+// valid C++ identifier from a YAML key
+std::string identifier(const std::string& key)
+{
+    std::string id;
+    for (auto c : key) id += std::isalnum((unsigned char)c) ? c : '_';
+    if (id.empty() or std::isdigit((unsigned char)id.front())) id = "_" + id;
+    if (CPP_KEYWORDS.count(id)) id += "_";
+    return id;
+}
+
+// CamelCase identifier: "base_input" -> "BaseInput"
+std::string camelCase(const std::string& name)
+{
+    std::string camel;
+    bool        upper = true;
+    for (auto c : name)
+    {
+        if (not std::isalnum((unsigned char)c))
+        {
+            upper = true;
+            continue;
+        }
+        camel += upper ? (char)std::toupper((unsigned char)c) : c;
+        upper = false;
+    }
+    if (camel.empty() or std::isdigit((unsigned char)camel.front())) camel = "T" + camel;
+    return camel;
+}
+
+std::string stringLiteral(const std::string& str)
+{
+    std::string literal = "\"";
+    for (auto c : str)
+    {
+        if (c == '"' or c == '\\')
+            literal += std::string("\\") + c;
+        else if (c == '\n')
+            literal += "\\n";
+        else if (std::isprint((unsigned char)c))
+            literal += c;
+        else
+        {
+            char octal[8];
+            std::snprintf(octal, sizeof(octal), "\\%03o", (unsigned char)c);
+            literal += octal;
+        }
+    }
+    return literal + "\"";
+}
+
+// YAML text of a node in a single line (to be embedded in the generated code)
+std::string yamlLiteral(const YAML::Node& node)
+{
+    YAML::Emitter emitter;
+    emitter << YAML::Flow << node;
+    return stringLiteral(emitter.c_str());
+}
+
+std::string oneLine(std::string str)
+{
+    std::replace(str.begin(), str.end(), '\n', ' ');
+    return str;
+}
+
+const std::map<std::string, std::string> BASIC_TYPES{{"bool", "bool"},
+                                                     {"char", "char"},
+                                                     {"int", "int"},
+                                                     {"unsigned int", "unsigned int"},
+                                                     {"long int", "long int"},
+                                                     {"long unsigned int", "long unsigned int"},
+                                                     {"float", "float"},
+                                                     {"double", "double"},
+                                                     {"string", "std::string"},
+                                                     {"std::string", "std::string"}};
+
+const char* HELPERS = R"(inline bool fail(std::string& error, const std::string& path, const std::string& message)
+{
+    error = "ERROR in '" + path + "': " + message;
+    return false;
+}
+
+inline std::string join(const std::string& path, const std::string& key)
+{
+    return path.empty() ? key : path + "/" + key;
+}
+
+template <typename T>
+inline bool load(const YAML::Node& node, T& value, std::string& error, const std::string& path)
+{
+    try
+    {
+        if (YAML::convert<T>::decode(node, value)) return true;
+    }
+    catch (const std::exception& e)
+    {
+    }
+    return fail(error, path, "Wrong type");
+}
+
+template <typename T>
+inline bool load(const YAML::Node& node, std::vector<T>& value, std::string& error, const std::string& path)
+{
+    if (not node.IsSequence()) return fail(error, path, "Should be a sequence");
+    value.resize(node.size());
+    std::size_t i = 0;
+    for (auto it = node.begin(); it != node.end(); ++it, ++i)
+    {
+        T element;
+        if (not load(*it, element, error, path + "[" + std::to_string(i) + "]")) return false;
+        value[i] = element;
+    }
+    return true;
+}
+
+// sizes of each level of nested sequences (0: any size)
+inline bool checkSizes(const YAML::Node&               node,
+                       const std::vector<std::size_t>& sizes,
+                       std::size_t                     level,
+                       std::string&                    error,
+                       const std::string&              path)
+{
+    if (level == sizes.size()) return true;
+    if (not node.IsSequence()) return fail(error, path, "Should be a sequence");
+    if (sizes[level] != 0 and node.size() != sizes[level])
+        return fail(error, path, "Wrong size, should be " + std::to_string(sizes[level]));
+    std::size_t i = 0;
+    for (auto it = node.begin(); it != node.end(); ++it, ++i)
+        if (not checkSizes(*it, sizes, level + 1, error, path + "[" + std::to_string(i) + "]")) return false;
+    return true;
+}
+
+template <typename T>
+inline bool equal(const T& value1, const T& value2)
+{
+    return value1 == value2;
+}
+
+template <typename T>
+inline bool equal(const std::vector<T>& value1, const std::vector<T>& value2)
+{
+    if (value1.size() != value2.size()) return false;
+    for (std::size_t i = 0; i < value1.size(); i++)
+        if (not equal(value1[i], value2[i])) return false;
+    return true;
+}
+
+inline bool equal(const YAML::Node& value1, const YAML::Node& value2)
+{
+    return YAML::Dump(value1) == YAML::Dump(value2);
+}
+
+template <typename T, std::size_t N>
+inline bool isInOptions(const T& value, const T (&options)[N])
+{
+    for (auto& option : options)
+        if (equal(value, option)) return true;
+    return false;
+}
+
+template <typename T>
+inline T fromYaml(const char* yaml)
+{
+    T           value;
+    std::string error;
+    if (not load(YAML::Load(yaml), value, error, "")) throw std::runtime_error(error);
+    return value;
+}
+)";
+
+const char* HELPERS_EIGEN = R"(
+template <typename S, int R, int C, int O, int MR, int MC>
+inline bool equal(const Eigen::Matrix<S, R, C, O, MR, MC>& value1, const Eigen::Matrix<S, R, C, O, MR, MC>& value2)
+{
+    return value1.rows() == value2.rows() and value1.cols() == value2.cols() and
+           (value1.size() == 0 or (value1 - value2).cwiseAbs().maxCoeff() < 1e-9);
+}
+)";
+
+const char* HELPERS_EXPRESSION = R"(
+// evaluate the expression of 'mandatory' (see yaml_schema_cpp::evalExpression())
+inline bool isMandatory(const char*        expression,
+                        const YAML::Node&  scope,
+                        bool&              mandatory,
+                        std::string&       error,
+                        const std::string& path)
+{
+    try
+    {
+        mandatory = ::yaml_schema_cpp::evalExpression(expression, scope);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        return fail(error, path, std::string("Evaluating schema expression for 'mandatory' failed with error: ") +
+                                     e.what());
+    }
+}
+)";
+
+class CodeGenerator
+{
+  public:
+    CodeGenerator(const std::vector<std::string>& folders_schema, bool override)
+        : folders_schema_(folders_schema), override_(override), uses_eigen_(false), uses_expression_(false)
+    {
+    }
+
+    std::string generate(const std::string& name_schema, const std::string& name_space)
+    {
+        std::stringstream log;
+        auto              compiled_schema = getCompiledSchema(name_schema, folders_schema_, log, override_);
+        if (not compiled_schema) throw std::runtime_error("generateCode: couldn't load the schema: " + log.str());
+
+        auto name        = filesystem::path(compiled_schema->path).stem().string();
+        auto struct_name = generateStruct(compiled_schema->node, camelCase(name));
+
+        std::stringstream code;
+        code << "#pragma once\n\n";
+        code << "// Generated by yaml-schema-cpp from schema '" << name_schema << "'. Do not edit.\n";
+        code << "// Regenerate it if the schema (or the schemas it uses) changes.\n\n";
+        code << "#include <cstddef>\n#include <stdexcept>\n#include <string>\n#include <vector>\n\n";
+        code << "#include \"yaml-cpp/yaml.h\"\n";
+        if (uses_eigen_) code << "#include \"yaml-schema-cpp/yaml_conversion.hpp\"\n";
+        if (uses_expression_) code << "#include \"yaml-schema-cpp/expression.hpp\"\n";
+        code << "\nnamespace " << identifier(name_space.empty() ? name : name_space) << "\n{\n";
+        code << HELPERS;
+        if (uses_eigen_) code << HELPERS_EIGEN;
+        if (uses_expression_) code << HELPERS_EXPRESSION;
+        for (auto definition : definitions_) code << "\n" << definition;
+        code << "\ninline bool validateAndLoad(const YAML::Node& node, " << struct_name
+             << "& output, std::string& error)\n{\n    return load(node, output, error, \"\");\n}\n";
+        code << "\ninline " << struct_name << " validateAndLoad(const YAML::Node& node)\n{\n";
+        code << "    " << struct_name << " output;\n    std::string error;\n";
+        code << "    if (not load(node, output, error, \"\")) throw std::runtime_error(error);\n";
+        code << "    return output;\n}\n\n}\n";
+
+        return code.str();
+    }
+
+  private:
+    std::string uniqueStructName(const std::string& name)
+    {
+        auto unique_name = name;
+        for (auto i = 2; struct_names_.count(unique_name); i++) unique_name = name + std::to_string(i);
+        struct_names_.insert(unique_name);
+        return unique_name;
+    }
+
+    std::string cppType(const std::string& type)
+    {
+        if (isArrayType(type)) return "std::vector<" + cppType(getLowerElementType(type)) + ">";
+
+        // derived: validated with the schema of its 'type', only known at runtime
+        if (isDerivedType(type))
+            throw std::runtime_error("generateCode: derived types are not supported (" + type +
+                                     "), validate them with applySchema()");
+
+        auto basic = BASIC_TYPES.find(type);
+        if (basic != BASIC_TYPES.end()) return basic->second;
+
+#if _EIGEN_FOUND == 1
+        EigenType eigen_type;
+        if (parseEigenType(type, eigen_type))
+        {
+            uses_eigen_ = true;
+            auto size   = [](int s) { return s == Eigen::Dynamic ? std::string("Eigen::Dynamic") : std::to_string(s); };
+            std::string scalar = eigen_type.scalar == EigenType::DOUBLE  ? "double"
+                                 : eigen_type.scalar == EigenType::FLOAT ? "float"
+                                                                         : "int";
+            return "Eigen::Matrix<" + scalar + ", " + size(eigen_type.rows) + ", " + size(eigen_type.cols) + ">";
+        }
+#endif
+
+        // custom type
+        auto custom = custom_types_.find(type);
+        if (custom != custom_types_.end())
+        {
+            if (custom->second.empty()) throw std::runtime_error("generateCode: recursive type " + type);
+            return custom->second;
+        }
+        custom_types_[type] = "";  // in progress
+
+        std::stringstream log;
+        YAML::Node        node_schema_type;
+        if (not resolveTypeSchema(type, folders_schema_, node_schema_type, log, override_))
+            throw std::runtime_error("generateCode: couldn't load the schema of type " + type + ": " + log.str());
+
+        return custom_types_[type] = generateStruct(node_schema_type, camelCase(type));
+    }
+
+    // sizes of all array levels, empty if none is fixed
+    std::vector<size_t> fixedSizes(std::string type)
+    {
+        std::vector<size_t> sizes;
+        bool                any_fixed = false;
+        size_t              size;
+        while (isArrayType(type, size))
+        {
+            sizes.push_back(size);
+            any_fixed = any_fixed or size != 0;
+            type      = getLowerElementType(type);
+        }
+        return any_fixed ? sizes : std::vector<size_t>();
+    }
+
+    // C++ expression with the value of node (validated as type)
+    std::string valueExpression(const YAML::Node& node, const std::string& type, const std::string& cpp_type)
+    {
+        if (not isArrayType(type) and BASIC_TYPES.count(type) and node.IsScalar())
+        {
+            if (cpp_type == "std::string") return "std::string(" + stringLiteral(node.Scalar()) + ")";
+            if (cpp_type == "bool") return node.as<bool>() ? "true" : "false";
+            if (cpp_type == "char") return "static_cast<char>(" + std::to_string((int)node.as<char>()) + ")";
+            if (cpp_type == "float" or cpp_type == "double")
+            {
+                auto value = node.as<double>();
+                if (value == value and value - value == 0)  // finite
+                {
+                    char literal[64];
+                    std::snprintf(literal, sizeof(literal), "%.17g", value);
+                    return cpp_type + "(" + literal + ")";
+                }
+            }
+            else if (cpp_type == "unsigned int" or cpp_type == "long unsigned int")
+                return cpp_type + "(" + std::to_string(node.as<unsigned long long>()) + "ULL)";
+            else
+                return cpp_type + "(" + std::to_string(node.as<long long>()) + "LL)";
+        }
+        return "fromYaml<" + cpp_type + " >(" + yamlLiteral(node) + ")";
+    }
+
+    // 'scope': the map is copied in 'scope' to evaluate expressions, completed with the values of missing fields
+    std::string generateField(const std::string& key, const YAML::Node& node_schema, bool scope)
+    {
+        auto member   = identifier(key);
+        auto key_lit  = stringLiteral(key);
+        auto path     = "join(path, " + key_lit + ")";
+        auto type     = node_schema[TYPE].as<std::string>();
+        auto cpp_type = cppType(type);
+
+        std::stringstream code;
+        code << "    // " << oneLine(key) << ": " << oneLine(node_schema[DOC].as<std::string>()) << "\n";
+        code << "    {\n";
+        code << "        const YAML::Node field = map[" << key_lit << "];\n";
+        if (node_schema[VALUE])
+            code << "        static const " << cpp_type << " value = "
+                 << valueExpression(node_schema[VALUE], type, cpp_type) << ";\n";
+        if (node_schema[OPTIONS])
+        {
+            code << "        static const " << cpp_type << " options[] = {";
+            for (auto i = 0; i < node_schema[OPTIONS].size(); i++)
+                code << (i == 0 ? "" : ", ") << valueExpression(node_schema[OPTIONS][i], type, cpp_type);
+            code << "};\n";
+        }
+
+        // existing
+        code << "        if (field.IsDefined())\n        {\n";
+        auto sizes = fixedSizes(type);
+        if (not sizes.empty())
+        {
+            code << "            if (not checkSizes(field, {";
+            for (auto i = 0; i < sizes.size(); i++) code << (i == 0 ? "" : ", ") << sizes[i];
+            code << "}, 0, error, " << path << ")) return false;\n";
+        }
+        code << "            if (not load(field, output." << member << ", error, " << path << ")) return false;\n";
+        if (node_schema[VALUE])
+            code << "            if (not equal(output." << member << ", value))\n                return fail(error, "
+                 << path << ", \"already defined in schema with a different value. Not allowed to be changed.\");\n";
+        if (node_schema[OPTIONS])
+            code << "            if (not isInOptions(output." << member << ", options))\n"
+                 << "                return fail(error, " << path
+                 << ", \"Wrong value. Allowed values defined in OPTIONS.\");\n";
+        code << "        }\n";
+
+        // missing
+        code << "        else\n        {\n";
+        if (node_schema[VALUE])
+        {
+            code << "            output." << member << " = value;\n";
+            if (scope)
+                code << "            scope[" << key_lit << "] = YAML::Load(" << yamlLiteral(node_schema[VALUE])
+                     << ");\n";
+        }
+        else if (isExpression(node_schema[MANDATORY]))
+        {
+            code << "            bool mandatory;\n";
+            code << "            if (not isMandatory(" << stringLiteral(node_schema[MANDATORY].as<std::string>())
+                 << ", scope, mandatory, error, " << path << "))\n";
+            code << "                return false;\n";
+            code << "            if (mandatory) return fail(error, " << path << ", \"Missing mandatory field.\");\n";
+            if (node_schema[DEFAULT])
+            {
+                code << "            output." << member << " = "
+                     << valueExpression(node_schema[DEFAULT], type, cpp_type) << ";\n";
+                code << "            scope[" << key_lit << "] = YAML::Load(" << yamlLiteral(node_schema[DEFAULT])
+                     << ");\n";
+            }
+        }
+        else if (node_schema[MANDATORY].as<bool>())
+            code << "            return fail(error, " << path << ", \"Missing mandatory field.\");\n";
+        else if (node_schema[DEFAULT])
+        {
+            code << "            static const " << cpp_type << " default_value = "
+                 << valueExpression(node_schema[DEFAULT], type, cpp_type) << ";\n";
+            code << "            output." << member << " = default_value;\n";
+            if (scope)
+                code << "            scope[" << key_lit << "] = YAML::Load(" << yamlLiteral(node_schema[DEFAULT])
+                     << ");\n";
+        }
+        code << "        }\n    }\n";
+
+        return code.str();
+    }
+
+    // struct, equal() and load() of a map of the schema, returns the name of the struct
+    std::string generateStruct(const YAML::Node& node_schema, const std::string& name)
+    {
+        auto struct_name = uniqueStructName(name);
+
+        // expressions in 'mandatory' are evaluated with the map completed with the missing fields (as applySchema())
+        bool scope = false;
+        for (auto node_schema_child : node_schema)
+            if (isSpecification(node_schema_child.second) and isExpression(node_schema_child.second[MANDATORY]))
+                scope = true;
+        uses_expression_ = uses_expression_ or scope;
+
+        std::stringstream members, equals, loads;
+        std::set<std::string> used_members;
+        for (auto node_schema_child : node_schema)
+        {
+            auto key    = node_schema_child.first.as<std::string>();
+            auto member = identifier(key);
+            if (not used_members.insert(member).second)
+                throw std::runtime_error("generateCode: keys with the same C++ identifier in " + name + ": " + key);
+
+            // specification
+            if (isSpecification(node_schema_child.second))
+            {
+                auto cpp_type = cppType(node_schema_child.second[TYPE].as<std::string>());
+                members << "    " << cpp_type << " " << member << "{};  // "
+                        << oneLine(node_schema_child.second[DOC].as<std::string>()) << "\n";
+                loads << generateField(key, node_schema_child.second, scope);
+            }
+            // map
+            else
+            {
+                auto child_struct = generateStruct(node_schema_child.second, struct_name + camelCase(key));
+                members << "    " << child_struct << " " << member << ";\n";
+                loads << "    if (not load(map[" << stringLiteral(key) << "], output." << member
+                      << ", error, join(path, " << stringLiteral(key) << "))) return false;\n";
+            }
+            equals << "\n           and equal(value1." << member << ", value2." << member << ")";
+        }
+
+        std::stringstream code;
+        code << "struct " << struct_name << "\n{\n" << members.str() << "};\n\n";
+        code << "inline bool equal(const " << struct_name << "& value1, const " << struct_name << "& value2)\n{\n";
+        code << "    return true" << equals.str() << ";\n}\n\n";
+        code << "inline bool load(const YAML::Node& node, " << struct_name
+             << "& output, std::string& error, const std::string& path)\n{\n";
+        code << "    if (node.IsDefined() and not node.IsMap() and not node.IsNull())\n";
+        code << "        return fail(error, path, \"Should be a map\");\n";
+        code << "    // missing map: all its fields missing\n";
+        code << "    const YAML::Node map = node.IsDefined() ? node : YAML::Node();\n";
+        if (scope) code << "    YAML::Node       scope = YAML::Clone(map);\n";
+        code << "\n";
+        code << loads.str();
+        code << "    return true;\n}\n";
+
+        definitions_.push_back(code.str());
+
+        return struct_name;
+    }
+
+    std::vector<std::string>           folders_schema_;
+    bool                               override_;
+    bool                               uses_eigen_;
+    bool                               uses_expression_;
+    std::vector<std::string>           definitions_;   // in dependency order
+    std::map<std::string, std::string> custom_types_;  // type -> struct name
+    std::set<std::string>              struct_names_;
+};
+}  // namespace
+
+std::string generateCode(const std::string&              name_schema,
+                         const std::vector<std::string>& folders_schema,
+                         const std::string&              name_space,
+                         bool                            override)
+{
+    CodeGenerator generator(folders_schema, override);
+    return generator.generate(name_schema, name_space);
+}
+
+std::string generateCodeFile(std::string                     filepath,
+                             const std::string&              name_schema,
+                             const std::vector<std::string>& folders_schema,
+                             const std::string&              name_space,
+                             bool                            override)
+{
+    // Check extension
+    if (filesystem::path(filepath).extension().empty()) filepath += ".hpp";
+
+    // Check that directory of the file exists
+    filesystem::path fp = filepath;
+    if (not fp.parent_path().empty() and not filesystem::exists(fp.parent_path()))
+        throw std::runtime_error("generateCodeFile: wrong file path: " + filepath);
+
+    auto code = generateCode(name_schema, folders_schema, name_space, override);
+
+    // Create file
+    std::ofstream code_file(fp.c_str(), std::ofstream::out);
+    if (not code_file.is_open())
+        throw std::runtime_error(std::string("generateCodeFile: Failed to open the file: ") + fp.c_str());
+    code_file << code;
+    code_file.close();
+
+    return fp.string();
+}
+
+}  // namespace yaml_schema_cpp
@@ -1,4 +1,8 @@
 #include "yaml-schema-cpp/expression.hpp"
+
+#include <memory>
+#include <unordered_map>
+
 #include "yaml-schema-cpp/exprtk/exprtk.hpp"
 #include "yaml-schema-cpp/type_check.hpp"
 #include "yaml-schema-cpp/yaml_schema.hpp"
@@ -10,6 +14,35 @@ typedef exprtk::parser<double>                     parser_t;
 typedef exprtk::symbol_table<double>               symbol_table_t;
 typedef typename parser_t::unknown_symbol_resolver usr_t;
 
+enum class SymbolType
+{
+    NONE,
+    NUMERIC,
+    STRING
+};
+
+// value of an input node as expression variable (bool as 0/1, string last since it is always possible)
+SymbolType symbolValue(const YAML::Node& node, double& value, std::string& string_value)
+{
+    if (not node) return SymbolType::NONE;
+    if (tryNodeAs(node, "bool"))
+    {
+        value = node.as<bool>() ? 1 : 0;
+        return SymbolType::NUMERIC;
+    }
+    if (tryNodeAs(node, "double"))
+    {
+        value = node.as<double>();
+        return SymbolType::NUMERIC;
+    }
+    if (tryNodeAs(node, "string"))
+    {
+        string_value = node.as<std::string>();
+        return SymbolType::STRING;
+    }
+    return SymbolType::NONE;
+}
+
 struct yaml_USR : public parser_t::unknown_symbol_resolver
 {
     YAML::Node node_;
@@ -18,49 +51,39 @@ struct yaml_USR : public parser_t::unknown_symbol_resolver
 
     virtual bool process(const std::string& unknown_symbol, symbol_table_t& symbol_table, std::string& error_message)
     {
-        bool result = false;
+        bool        result = false;
+        double      value  = 0;
+        std::string string_val;
 
         // inexistent
         if (not node_[unknown_symbol])
         {
             error_message = "Indeterminable symbol type.";
+            return false;
         }
-        // boolean
-        else if (tryNodeAs(node_[unknown_symbol], "bool"))
+        switch (symbolValue(node_[unknown_symbol], value, string_val))
         {
-            double value = node_[unknown_symbol].as<bool>() ? 1 : 0;
-            result       = symbol_table.create_variable(unknown_symbol, value);
+            // boolean or scalar
+            case SymbolType::NUMERIC:
+                result = symbol_table.create_variable(unknown_symbol, value);
 
-            if (not result)
-            {
-                error_message = "Failed to create variable " + unknown_symbol + " with value " + std::to_string(value);
-            }
-        }
-        // scalar
-        else if (tryNodeAs(node_[unknown_symbol], "double"))
-        {
-            double value = node_[unknown_symbol].as<double>();
-            result       = symbol_table.create_variable(unknown_symbol, value);
+                if (not result)
+                {
+                    error_message =
+                        "Failed to create variable " + unknown_symbol + " with value " + std::to_string(value);
+                }
+                break;
+            // string
+            case SymbolType::STRING:
+                result = symbol_table.create_stringvar(unknown_symbol, string_val);
 
-            if (not result)
-            {
-                error_message = "Failed to create variable " + unknown_symbol + " with value " + std::to_string(value);
-            }
-        }
-        // string (last one since it is always possible to take as string)
-        else if (tryNodeAs(node_[unknown_symbol], "string"))
-        {
-            std::string string_val = node_[unknown_symbol].as<std::string>();
-            result                 = symbol_table.create_stringvar(unknown_symbol, string_val);
-
-            if (not result)
-            {
-                error_message = "Failed to create string variable " + unknown_symbol + " with value " + string_val;
-            }
-        }
-        else
-        {
-            error_message = "yaml_USR: unknown case.";
+                if (not result)
+                {
+                    error_message = "Failed to create string variable " + unknown_symbol + " with value " + string_val;
+                }
+                break;
+            default:
+                error_message = "yaml_USR: unknown case.";
         }
         return result;
     }
@@ -127,6 +150,145 @@ struct schema_USR : public parser_t::unknown_symbol_resolver
     }
 };
 
+namespace
+{
+std::string compileErrors(const parser_t& parser)
+{
+    std::string err = "bad syntax:";
+    for (std::size_t i = 0; i < parser.error_count(); ++i)
+    {
+        auto error = parser.get_error(i);
+        err += "\nError " + std::to_string(i) + " (position " + std::to_string(error.token.position) +
+               "): " + error.diagnostic.c_str();
+    }
+    return err;
+}
+
+// Expression compiled once for the variable types of an input node. Its variables are bound by reference, so it can
+// be evaluated for other nodes (with the same types) just assigning their values.
+class CompiledExpression
+{
+  public:
+    // throws if it does not compile (syntax or variables not found in node_input_parent)
+    CompiledExpression(const std::string& expression_str, const YAML::Node& node_input_parent)
+    {
+        yaml_USR yaml_usr(node_input_parent);
+        parser_t parser;
+        expression_.register_symbol_table(symbol_table_);
+        parser.enable_unknown_symbol_resolver(&yaml_usr);
+
+        // check exprtk syntax validity
+        if (not parser.compile(expression_str, expression_))
+        {
+            throw std::runtime_error("evalExpression: An error occurred compiling expression: " + expression_str +
+                                     " | " + compileErrors(parser));
+        }
+
+        // variables created by the symbol resolver
+        std::vector<std::string> names;
+        symbol_table_.get_variable_list(names);
+        for (const auto& name : names) variables_.push_back({name, &symbol_table_.get_variable(name)->ref(), nullptr});
+        names.clear();
+        symbol_table_.get_stringvar_list(names);
+        for (const auto& name : names)
+            variables_.push_back({name, nullptr, &symbol_table_.get_stringvar(name)->ref()});
+    }
+
+    CompiledExpression(const CompiledExpression&) = delete;
+    CompiledExpression& operator=(const CompiledExpression&) = delete;
+
+    // assign the variables from node_input_parent (false if any is missing or its type is not the compiled one)
+    bool assign(const YAML::Node& node_input_parent)
+    {
+        double      value = 0;
+        std::string string_value;
+        for (const auto& variable : variables_)
+        {
+            if (not read(variable, node_input_parent, value, string_value)) return false;
+            if (variable.string_value)
+                variable.string_value->swap(string_value);
+            else
+                *variable.value = value;
+        }
+        return true;
+    }
+
+    bool value()
+    {
+        return (bool)expression_.value();
+    }
+
+    // value for all nodes: the variables are gathered in columns and the expression is evaluated in a single loop
+    // (nodes whose variables do not match the compiled types are evaluated on their own, see evalExpression())
+    std::vector<bool> values(const std::string& expression_str, const std::vector<YAML::Node>& nodes_input_parent)
+    {
+        auto n = nodes_input_parent.size();
+
+        std::vector<bool>                     matches(n, true);
+        std::vector<std::vector<double>>      columns(variables_.size());
+        std::vector<std::vector<std::string>> string_columns(variables_.size());
+        double                                element_value = 0;
+        std::string                           element_string_value;
+        for (size_t j = 0; j < variables_.size(); j++)
+        {
+            if (variables_[j].string_value)
+                string_columns[j].resize(n);
+            else
+                columns[j].resize(n);
+            for (size_t i = 0; i < n; i++)
+            {
+                if (not matches[i]) continue;
+                matches[i] = read(variables_[j], nodes_input_parent[i], element_value, element_string_value);
+                if (variables_[j].string_value)
+                    string_columns[j][i].swap(element_string_value);
+                else
+                    columns[j][i] = element_value;
+            }
+        }
+
+        std::vector<bool> results(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            if (not matches[i])
+            {
+                results[i] = evalExpression(expression_str, nodes_input_parent[i]);
+                continue;
+            }
+            for (size_t j = 0; j < variables_.size(); j++)
+            {
+                if (variables_[j].string_value)
+                    variables_[j].string_value->swap(string_columns[j][i]);
+                else
+                    *variables_[j].value = columns[j][i];
+            }
+            results[i] = value();
+        }
+        return results;
+    }
+
+  private:
+    struct Variable
+    {
+        std::string  name;
+        double*      value;         // numeric variable (bool as 0/1)
+        std::string* string_value;  // string variable
+    };
+
+    static bool read(const Variable&    variable,
+                     const YAML::Node&  node_input_parent,
+                     double&            value,
+                     std::string&       string_value)
+    {
+        auto type = symbolValue(node_input_parent[variable.name], value, string_value);
+        return type == (variable.string_value ? SymbolType::STRING : SymbolType::NUMERIC);
+    }
+
+    symbol_table_t        symbol_table_;
+    expression_t          expression_;
+    std::vector<Variable> variables_;
+};
+}  // namespace
+
 bool isExpression(const YAML::Node& node)
 {
     return node.as<std::string>().front() == '$';
@@ -157,7 +319,6 @@ bool checkExpression(const YAML::Node& node_expression, const YAML::Node& node_s
     parser_t       parser;
     expression.register_symbol_table(symbol_table);
     parser.enable_unknown_symbol_resolver(&schema_usr);
-    parser.compile(expression_str, expression);
 
     // check exprtk syntax validity
     if (not parser.compile(expression_str, expression))
@@ -183,31 +344,29 @@ bool evalExpression(std::string expression_str, const YAML::Node& node_input_par
     // Preprocess: remove '$'
     preProcessExpression(expression_str);
 
-    // Parser with our symbol resolver for schemas
-    expression_t   expression;
-    symbol_table_t symbol_table;
-    yaml_USR       yaml_usr(node_input_parent);
-    parser_t       parser;
-    expression.register_symbol_table(symbol_table);
-    parser.enable_unknown_symbol_resolver(&yaml_usr);
-    parser.compile(expression_str, expression);
+    // compiled expressions of this thread, compiled again only if the variable types change
+    thread_local std::unordered_map<std::string, std::unique_ptr<CompiledExpression>> compiled_expressions;
 
-    // check exprtk syntax validity
-    if (not parser.compile(expression_str, expression))
+    auto& compiled = compiled_expressions[expression_str];
+    if (not compiled or not compiled->assign(node_input_parent))
     {
-        std::string err = "bad syntax:";
-        for (std::size_t i = 0; i < parser.error_count(); ++i)
-        {
-            auto error = parser.get_error(i);
-            err += "\nError " + std::to_string(i) + " (position " + std::to_string(error.token.position) +
-                   "): " + error.diagnostic.c_str();
-        }
-
-        throw std::runtime_error("evalExpression: An error occurred compiling expression: " + expression_str + " | " +
-                                 err);
+        compiled.reset(new CompiledExpression(expression_str, node_input_parent));
     }
+    return compiled->value();
+}
+
+std::vector<bool> evalExpressionBatch(std::string expression_str, const std::vector<YAML::Node>& nodes_input_parent)
+{
+    assert(isExpression(expression_str) and "evalExpressionBatch: expression does not contain an expression");
+
+    if (nodes_input_parent.empty()) return {};
+
+    // compiled once (with the variable types of the first node)
+    std::string compiled_str = expression_str;
+    preProcessExpression(compiled_str);
+    CompiledExpression compiled(compiled_str, nodes_input_parent.front());
 
-    return (bool)expression.value();
+    return compiled.values(expression_str, nodes_input_parent);
 }
 
 void preProcessExpression(std::string& expression_str)
@@ -0,0 +1,309 @@
+#include "yaml-schema-cpp/schema_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/type_check.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+std::mutex                                                   cache_mutex;
+std::map<std::string, std::shared_ptr<const CompiledSchema>> compiled_schemas;
+
+std::string cacheKey(const std::string& name_schema, const std::vector<std::string>& folders_schema, bool override)
+{
+    std::string key = name_schema + (override ? "|1" : "|0");
+    for (auto folder : folders_schema) key += "|" + folder;
+    return key;
+}
+
+std::atomic<long long> check_interval(1000000000);  // nanoseconds
+
+long long steadyTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// none of the files of the compiled schema modified (checked at most once per check interval)
+bool isUpToDate(const CompiledSchema& compiled)
+{
+    auto now = steadyTime();
+    if (now - compiled.check_time < check_interval) return true;
+
+    for (const auto& file : compiled.files)
+        if (lastWriteTime(file.path) != file.write_time) return false;
+
+    compiled.check_time = now;
+    return true;
+}
+
+void compileOptions(const YAML::Node&               node_schema,
+                    const std::vector<std::string>& folders_schema,
+                    CompiledSchema&                 compiled)
+{
+    if (not node_schema.IsMap()) return;
+
+    if (isSpecification(node_schema))
+    {
+        auto type = node_schema[TYPE].as<std::string>();
+        if (not node_schema[OPTIONS] or isDerivedType(type)) return;
+
+        std::stringstream log;
+        YAML::Node        node_schema_type;
+        if (not resolveTypeSchema(type, folders_schema, node_schema_type, log)) return;
+
+        compiled.options[nodeIdentity(node_schema[OPTIONS])] =
+            std::make_shared<const OptionsSet>(node_schema[OPTIONS], type, node_schema_type, folders_schema);
+    }
+    else
+    {
+        for (auto node_schema_child : node_schema) compileOptions(node_schema_child.second, folders_schema, compiled);
+    }
+}
+
+void collectReferences(const YAML::Node&               node,
+                       const std::vector<std::string>& folders_schema,
+                       std::set<std::string>&          references,
+                       std::set<std::string>&          followed);
+
+// schemas referenced by the schema files followed (not found or not loadable files are ignored)
+void collectFollowed(const YAML::Node&               node_follow,
+                     const std::vector<std::string>& folders_schema,
+                     std::set<std::string>&          references,
+                     std::set<std::string>&          followed)
+{
+    if (node_follow.IsSequence())
+    {
+        for (auto node_follow_i : node_follow) collectFollowed(node_follow_i, folders_schema, references, followed);
+        return;
+    }
+    if (not node_follow.IsScalar()) return;
+
+    // only schemas (see flattenNode())
+    auto name_follow = node_follow.as<std::string>();
+    if (filesystem::path(name_follow).extension().empty()) name_follow += SCHEMA_EXTENSION;
+    if (filesystem::path(name_follow).extension() != SCHEMA_EXTENSION or not followed.insert(name_follow).second)
+        return;
+
+    try
+    {
+        collectReferences(
+            YAML::LoadFile(findFileRecursive(name_follow, folders_schema)), folders_schema, references, followed);
+    }
+    catch (const std::exception&)
+    {
+    }
+}
+
+// schemas referenced in TYPE and BASE of the specifications of a schema (and its followed files)
+void collectReferences(const YAML::Node&               node,
+                       const std::vector<std::string>& folders_schema,
+                       std::set<std::string>&          references,
+                       std::set<std::string>&          followed)
+{
+    if (not node.IsMap()) return;
+
+    for (auto node_child : node)
+    {
+        if (not node_child.first.IsScalar()) continue;
+        auto key = node_child.first.as<std::string>();
+
+        if (key == "follow")
+            collectFollowed(node_child.second, folders_schema, references, followed);
+        else if ((key == TYPE or key == BASE) and node_child.second.IsScalar())
+        {
+            auto type = getLowestElementType(node_child.second.as<std::string>());
+            if (not isTrivialType(type) and type != "derived") references.insert(type);
+        }
+        else
+            collectReferences(node_child.second, folders_schema, references, followed);
+    }
+}
+
+// schemas referenced by a schema (empty if it is not found or cannot be loaded)
+std::set<std::string> scanSchema(const std::string& name_schema, const std::vector<std::string>& folders_schema)
+{
+    std::set<std::string> references, followed;
+    try
+    {
+        std::stringstream log;
+        auto              path_schema = findSchema(name_schema, folders_schema, log);
+        if (not path_schema.empty())
+        {
+            followed.insert(filesystem::path(path_schema).filename().string());
+            collectReferences(YAML::LoadFile(path_schema), folders_schema, references, followed);
+        }
+    }
+    catch (const std::exception&)
+    {
+    }
+    return references;
+}
+
+bool prefetch(const std::string&              name_schema,
+              const std::vector<std::string>& folders_schema,
+              bool                            override,
+              unsigned int                    n_threads)
+{
+    // scan the schema files level by level: referenced schemas of each schema
+    std::map<std::string, std::set<std::string>> references;
+    std::mutex                                   references_mutex;
+    std::vector<std::string>                     level{name_schema};
+    while (not level.empty())
+    {
+        parallelForEach(level, n_threads, [&](const std::string& name) {
+            auto                        references_name = scanSchema(name, folders_schema);
+            std::lock_guard<std::mutex> lock(references_mutex);
+            references[name] = references_name;
+        });
+
+        std::set<std::string> next_level;
+        for (auto name : level)
+            for (auto reference : references[name])
+                if (not references.count(reference)) next_level.insert(reference);
+        level.assign(next_level.begin(), next_level.end());
+    }
+
+    // compile the schemas whose referenced schemas are already compiled (all the remaining ones if cycles)
+    std::set<std::string> pending;
+    for (auto reference : references) pending.insert(reference.first);
+    std::atomic<bool> all_compiled(true);
+    while (not pending.empty())
+    {
+        std::vector<std::string> ready;
+        for (auto name : pending)
+        {
+            auto is_ready = std::none_of(references[name].begin(),
+                                         references[name].end(),
+                                         [&](const std::string& reference) {
+                                             return reference != name and pending.count(reference);
+                                         });
+            if (is_ready) ready.push_back(name);
+        }
+        if (ready.empty()) ready.assign(pending.begin(), pending.end());
+
+        parallelForEach(ready, n_threads, [&](const std::string& name) {
+            std::stringstream log;
+            if (not getCompiledSchema(name, folders_schema, log, override)) all_compiled = false;
+        });
+        for (auto name : ready) pending.erase(name);
+    }
+    return all_compiled;
+}
+}  // namespace
+
+OptionsSet::OptionsSet(const YAML::Node&               options_node,
+                       const std::string&              type,
+                       const YAML::Node&               node_schema_type,
+                       const std::vector<std::string>& folders_schema)
+    : options_node_(options_node),
+      type_(type),
+      node_schema_type_(node_schema_type),
+      folders_schema_(folders_schema),
+      exact_(true)
+{
+    for (auto option : options_node_)
+    {
+        std::string key;
+        if (canonicalKey(option, type_, node_schema_type_, folders_schema_, key))
+            keys_.insert(key);
+        else
+            exact_ = false;
+    }
+}
+
+bool OptionsSet::contains(const YAML::Node& node) const
+{
+    std::string key;
+    if (canonicalKey(node, type_, node_schema_type_, folders_schema_, key))
+    {
+        if (keys_.count(key)) return true;
+        if (exact_) return false;
+    }
+    // no exact canonical key --> linear search
+    return isInOptionsResolved(node, options_node_, type_, node_schema_type_, folders_schema_);
+}
+
+std::shared_ptr<const CompiledSchema> getCompiledSchema(const std::string&              name_schema,
+                                                        const std::vector<std::string>& folders_schema,
+                                                        std::stringstream&              log,
+                                                        bool                            override)
+{
+    auto key = cacheKey(name_schema, folders_schema, override);
+
+    // cached and not modified (files checked without locking)
+    std::shared_ptr<const CompiledSchema> cached;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto                        it = compiled_schemas.find(key);
+        if (it != compiled_schemas.end()) cached = it->second;
+    }
+    if (cached and isUpToDate(*cached))
+    {
+        log << "schema file found: " << cached->path << std::endl;
+        return cached;
+    }
+
+    // compile (without locking, it may compile other schemas)
+    std::stringstream log_find_schema;
+    auto              path_schema = findSchema(name_schema, folders_schema, log_find_schema);
+    if (path_schema.empty())
+    {
+        log << "ERROR in loadSchema(): findSchema() failed with error: " << log_find_schema.str() << "\n";
+        return nullptr;
+    }
+    log << "schema file found: " << path_schema << std::endl;
+
+    auto compiled        = std::make_shared<CompiledSchema>();
+    compiled->path       = path_schema;
+    compiled->check_time = steadyTime();
+    compiled->node       = loadSchemaFile(path_schema, folders_schema, log, override, compiled->files);
+    if (not compiled->node.IsDefined()) return nullptr;
+
+    compileOptions(compiled->node, folders_schema, *compiled);
+
+    // store
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    compiled_schemas[key] = compiled;
+
+    return compiled;
+}
+
+std::shared_future<bool> prefetchSchemas(const std::string&              name_schema,
+                                         const std::vector<std::string>& folders_schema,
+                                         bool                            override,
+                                         unsigned int                    n_threads)
+{
+    return std::async(std::launch::async, prefetch, name_schema, folders_schema, override, n_threads).share();
+}
+
+std::shared_ptr<const OptionsSet> CompiledSchema::findOptions(const YAML::Node& options_node) const
+{
+    auto it = options.find(nodeIdentity(options_node));
+    return it == options.end() ? nullptr : it->second;
+}
+
+void setSchemaCacheCheckInterval(double seconds)
+{
+    check_interval = (long long)(seconds * 1e9);
+}
+
+void clearSchemaCache()
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    compiled_schemas.clear();
+}
+
+}  // namespace yaml_schema_cpp
@@ -1,4 +1,8 @@
 #include "yaml-schema-cpp/type_check.hpp"
+
+#include <cstring>
+#include <sstream>
+
 #include "yaml-schema-cpp/filesystem_wrapper.hpp"
 #include "yaml-schema-cpp/yaml_schema.hpp"
 #include "yaml-schema-cpp/yaml_utils.hpp"
@@ -70,7 +74,10 @@ bool checkNodeAsEigen(const YAML::Node& node, const std::string& type)
         for (auto i = 0; node.size(); i++) checkNodeAsString(node[i], getLowerElementType(type));
     }
     else
-        CHECK_TYPE_EIGEN_CASES
+    {
+        EigenType eigen_type;
+        if (parseEigenType(type, eigen_type)) return checkNodeAsMatrix(node, eigen_type);
+    }
     return false;
 }
 #endif
@@ -90,7 +97,8 @@ bool checkNodeAs(const YAML::Node& node, const std::string& type)
         CHECK_TYPE_BASIC_CASES
         CHECK_TYPE_STRING_CASES
 #if _EIGEN_FOUND == 1
-        CHECK_TYPE_EIGEN_CASES
+        EigenType eigen_type;
+        if (parseEigenType(type, eigen_type)) return checkNodeAsMatrix(node, eigen_type);
 #endif
     }
     return false;
@@ -163,6 +171,150 @@ bool isEigenType(const std::string& type)
 }
 #endif
 
+#if _EIGEN_FOUND == 1
+namespace
+{
+bool parseEigenScalar(const std::string& str, EigenType::Scalar& scalar)
+{
+    if (str == "double" or str == "d")
+        scalar = EigenType::DOUBLE;
+    else if (str == "float" or str == "f")
+        scalar = EigenType::FLOAT;
+    else if (str == "int" or str == "i")
+        scalar = EigenType::INT;
+    else
+        return false;
+    return true;
+}
+
+bool parseEigenSize(const std::string& str, int& size)
+{
+    if (str == "X" or str == "Dynamic" or str == "Eigen::Dynamic")
+    {
+        size = Eigen::Dynamic;
+        return true;
+    }
+    if (str.empty() or str.size() > 6 or str[0] == '0' or
+        str.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+
+    size = std::stoi(str);
+    return true;
+}
+
+std::string trim(const std::string& str)
+{
+    auto first = str.find_first_not_of(" \t");
+    if (first == std::string::npos) return "";
+    return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+}
+
+// Matrix<scalar, rows, cols>, Vector<scalar, size>, RowVector<scalar, size>
+bool parseEigenTemplate(const std::string& name, const std::string& args_str, EigenType& eigen_type)
+{
+    std::vector<std::string> args;
+    std::stringstream        ss(args_str);
+    std::string              arg;
+    while (std::getline(ss, arg, ',')) args.push_back(trim(arg));
+
+    if (args.empty() or not parseEigenScalar(args[0], eigen_type.scalar) or args[0].size() == 1) return false;
+
+    if (name == "Matrix" and args.size() == 3)
+        return parseEigenSize(args[1], eigen_type.rows) and parseEigenSize(args[2], eigen_type.cols);
+    if (name == "Vector" and args.size() == 2)
+    {
+        eigen_type.cols = 1;
+        return parseEigenSize(args[1], eigen_type.rows);
+    }
+    if (name == "RowVector" and args.size() == 2)
+    {
+        eigen_type.rows = 1;
+        return parseEigenSize(args[1], eigen_type.cols);
+    }
+    return false;
+}
+
+// {Vector,RowVector}{N,X}{d,f,i}, Matrix{N,X}[{N,X}]{d,f,i}
+bool parseEigenShorthand(const std::string& name, const std::string& suffix, EigenType& eigen_type)
+{
+    if (suffix.size() < 2 or not parseEigenScalar(suffix.substr(suffix.size() - 1), eigen_type.scalar))
+        return false;
+
+    // size tokens: 'X' or digits (two consecutive numbers are not possible)
+    std::vector<std::string> sizes;
+    for (auto i = 0; i < suffix.size() - 1; i++)
+    {
+        if (suffix[i] == 'X' or sizes.empty() or sizes.back() == "X")
+            sizes.push_back(std::string(1, suffix[i]));
+        else
+            sizes.back() += suffix[i];
+    }
+
+    if (name == "Vector" and sizes.size() == 1)
+    {
+        eigen_type.cols = 1;
+        return parseEigenSize(sizes[0], eigen_type.rows);
+    }
+    if (name == "RowVector" and sizes.size() == 1)
+    {
+        eigen_type.rows = 1;
+        return parseEigenSize(sizes[0], eigen_type.cols);
+    }
+    if (name == "Matrix" and sizes.size() == 1)
+    {
+        if (not parseEigenSize(sizes[0], eigen_type.rows)) return false;
+        eigen_type.cols = eigen_type.rows;
+        return true;
+    }
+    if (name == "Matrix" and sizes.size() == 2)
+        return parseEigenSize(sizes[0], eigen_type.rows) and parseEigenSize(sizes[1], eigen_type.cols);
+
+    return false;
+}
+}  // namespace
+
+bool parseEigenType(const std::string& type, EigenType& eigen_type)
+{
+    auto begin = type.compare(0, 7, "Eigen::") == 0 ? 7 : 0;
+
+    // name
+    std::string name;
+    for (auto candidate : {"Matrix", "Vector", "RowVector"})
+        if (type.compare(begin, std::strlen(candidate), candidate) == 0)
+        {
+            name = candidate;
+            break;
+        }
+    if (name.empty()) return false;
+
+    auto suffix = type.substr(begin + name.size());
+
+    // template form
+    if (not suffix.empty() and suffix.front() == '<')
+    {
+        if (suffix.back() != '>') return false;
+        return parseEigenTemplate(name, suffix.substr(1, suffix.size() - 2), eigen_type);
+    }
+
+    // shorthand form
+    return parseEigenShorthand(name, suffix, eigen_type);
+}
+
+bool checkNodeAsMatrix(const YAML::Node& node, const EigenType& eigen_type)
+{
+    switch (eigen_type.scalar)
+    {
+        case EigenType::DOUBLE:
+            return checkNodeAsMatrix<double>(node, eigen_type.rows, eigen_type.cols);
+        case EigenType::FLOAT:
+            return checkNodeAsMatrix<float>(node, eigen_type.rows, eigen_type.cols);
+        case EigenType::INT:
+            return checkNodeAsMatrix<int>(node, eigen_type.rows, eigen_type.cols);
+    }
+    return false;
+}
+#endif
+
 bool isNonTrivialType(const std::string& type, const std::vector<std::string>& folders)
 {
     std::stringstream log;
@@ -0,0 +1,186 @@
+#include "yaml-schema-cpp/validation_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+// FNV-1a
+void hashBytes(const std::string& bytes, std::uint64_t& hash)
+{
+    for (auto byte : bytes)
+    {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 1099511628211ULL;
+    }
+    hash ^= 0xff;  // separator: ("ab", "c") and ("a", "bc") have different hashes
+    hash *= 1099511628211ULL;
+}
+
+bool readFile(const std::string& path, std::string& contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (not file.is_open()) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+std::string toHex(std::uint64_t hash)
+{
+    std::stringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hex.str();
+}
+
+// hash of the contents of a file (see hashContents()), empty if it cannot be read
+std::string hashFile(const std::string& path)
+{
+    std::string contents;
+    if (not readFile(path, contents)) return "";
+    return hashContents(contents);
+}
+
+std::string cacheFile(const std::string& cache_folder, const std::string& fingerprint)
+{
+    return cache_folder + "/" + fingerprint + ".yaml";
+}
+
+// unique among threads and processes
+std::string temporaryFile(const std::string& path)
+{
+    static std::atomic<unsigned long> counter(0);
+    static const auto                 process_id = std::random_device()();
+
+    std::stringstream suffix;
+    suffix << ".tmp" << process_id << "_" << std::hash<std::thread::id>()(std::this_thread::get_id()) << "_"
+           << counter++;
+    return path + suffix.str();
+}
+}  // namespace
+
+std::string validationFingerprint(const std::string&              path_input,
+                                  const std::string&              name_schema,
+                                  const std::vector<std::string>& folders_schema,
+                                  bool                            override)
+{
+    std::string contents;
+    if (not readFile(path_input, contents)) return "";
+
+    std::uint64_t hash = 14695981039346656037ULL;
+    hashBytes(_YAML_SCHEMA_CPP_VERSION, hash);
+    hashBytes(filesystem::absolute(path_input).string(), hash);
+    hashBytes(contents, hash);
+    hashBytes(name_schema, hash);
+    hashBytes(override ? "1" : "0", hash);
+
+    // all schema files (sorted, the directory iteration order is not specified), by size and modification time
+    for (auto folder : folders_schema)
+    {
+        hashBytes(folder, hash);
+        if (not filesystem::is_directory(folder)) continue;
+
+        std::vector<std::string> paths_schema;
+        for (auto const& entry : filesystem::recursive_directory_iterator(folder))
+            if (filesystem::is_regular_file(entry) and entry.path().extension() == SCHEMA_EXTENSION)
+                paths_schema.push_back(entry.path().string());
+        std::sort(paths_schema.begin(), paths_schema.end());
+
+        for (auto path_schema : paths_schema)
+        {
+            hashBytes(path_schema, hash);
+            hashBytes(std::to_string(filesystem::file_size(path_schema)), hash);
+            hashBytes(std::to_string(lastWriteTime(path_schema)), hash);
+        }
+    }
+
+    return toHex(hash);
+}
+
+bool loadCachedValidation(const std::string& cache_folder, const std::string& fingerprint, CachedValidation& cached)
+{
+    auto path_cache = cacheFile(cache_folder, fingerprint);
+    if (fingerprint.empty() or not filesystem::exists(path_cache)) return false;
+
+    try
+    {
+        auto node_cache = YAML::LoadFile(path_cache);
+        if (not node_cache["version"] or node_cache["version"].as<std::string>() != _YAML_SCHEMA_CPP_VERSION)
+            return false;
+
+        // input and followed files not modified
+        if (not node_cache["files"]) return false;
+        for (auto node_file : node_cache["files"])
+            if (hashFile(node_file["path"].as<std::string>()) != node_file["hash"].as<std::string>()) return false;
+
+        cached.is_valid = node_cache["valid"].as<bool>();
+        cached.log      = node_cache["log"].as<std::string>();
+        cached.node     = node_cache["node"];
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+bool storeCachedValidation(const std::string&             cache_folder,
+                           const std::string&             fingerprint,
+                           const std::vector<LoadedFile>& loaded_files,
+                           const CachedValidation&        cached)
+{
+    if (fingerprint.empty()) return false;
+
+    auto path_cache     = cacheFile(cache_folder, fingerprint);
+    auto path_temporary = temporaryFile(path_cache);
+    try
+    {
+        YAML::Emitter emitter;
+        emitter << YAML::BeginMap;
+        emitter << YAML::Key << "version" << YAML::Value << _YAML_SCHEMA_CPP_VERSION;
+        emitter << YAML::Key << "files" << YAML::Value << YAML::BeginSeq;
+        for (const auto& loaded_file : loaded_files)
+        {
+            emitter << YAML::BeginMap;
+            emitter << YAML::Key << "path" << YAML::Value << filesystem::absolute(loaded_file.path).string();
+            emitter << YAML::Key << "hash" << YAML::Value << loaded_file.hash;
+            emitter << YAML::EndMap;
+        }
+        emitter << YAML::EndSeq;
+        emitter << YAML::Key << "valid" << YAML::Value << cached.is_valid;
+        emitter << YAML::Key << "log" << YAML::Value << YAML::DoubleQuoted << cached.log;
+        emitter << YAML::Key << "node" << YAML::Value << cached.node;
+        emitter << YAML::EndMap;
+        if (not emitter.good()) return false;
+
+        filesystem::create_directories(cache_folder);
+        {
+            std::ofstream file(path_temporary, std::ios::binary);
+            file << emitter.c_str() << std::endl;
+            if (not file.good()) throw std::runtime_error("storeCachedValidation: could not write " + path_temporary);
+        }
+        filesystem::rename(path_temporary, path_cache);
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        if (filesystem::exists(path_temporary)) filesystem::remove(path_temporary);
+        return false;
+    }
+}
+
+}  // namespace yaml_schema_cpp
@@ -0,0 +1,118 @@
+#include "yaml-schema-cpp/validation_session.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/schema_cache.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+// initialize the result, skipped if fail_fast and some document already failed
+bool skip(bool fail_fast, const std::atomic<bool>& failed, ValidationResult& result)
+{
+    result.is_valid   = false;
+    result.is_skipped = fail_fast and failed;
+    result.time       = 0;
+    if (result.is_skipped) result.log = "Skipped: another document is not valid (fail fast)\n";
+    return result.is_skipped;
+}
+
+void finish(const std::chrono::steady_clock::time_point& start, std::atomic<bool>& failed, ValidationResult& result)
+{
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (not result.is_valid) failed = true;
+}
+}  // namespace
+
+ValidationSession::ValidationSession(const std::vector<std::string>& folders_schema,
+                                     bool                            override,
+                                     unsigned int                    n_threads)
+    : folders_schema_(folders_schema), override_(override), n_threads_(n_threads)
+{
+}
+
+std::vector<ValidationResult> ValidationSession::applySchemaBatch(const std::vector<std::string>& paths_input,
+                                                                  const std::string&              name_schema,
+                                                                  bool                            fail_fast) const
+{
+    prefetch(name_schema);
+
+    std::vector<ValidationResult> results(paths_input.size());
+    std::vector<size_t>           indices(paths_input.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    std::atomic<bool> failed(false);
+    parallelForEach(indices, n_threads_, [&](size_t i) {
+        auto& result      = results[i];
+        result.path_input = paths_input[i];
+        if (skip(fail_fast, failed, result)) return;
+
+        auto start = std::chrono::steady_clock::now();
+
+        // load and flatten (as YamlServer::loadYaml())
+        try
+        {
+            result.node = YAML::LoadFile(paths_input[i]);
+            flattenNode(
+                result.node, filesystem::path(paths_input[i]).parent_path().string(), {}, false, override_, true);
+        }
+        catch (const std::exception& e)
+        {
+            result.log = "ERROR: Couldn't load the yaml file " + paths_input[i] + ". Error: " + e.what() + "\n";
+            finish(start, failed, result);
+            return;
+        }
+
+        std::stringstream log;
+        result.is_valid = applySchema(result.node, name_schema, folders_schema_, log, "", override_);
+        result.log      = log.str();
+        finish(start, failed, result);
+    });
+
+    return results;
+}
+
+std::vector<ValidationResult> ValidationSession::applySchemaBatch(const std::vector<YAML::Node>& nodes_input,
+                                                                  const std::string&             name_schema,
+                                                                  bool                           fail_fast) const
+{
+    prefetch(name_schema);
+
+    std::vector<ValidationResult> results(nodes_input.size());
+    std::vector<size_t>           indices(nodes_input.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    std::atomic<bool> failed(false);
+    parallelForEach(indices, n_threads_, [&](size_t i) {
+        if (skip(fail_fast, failed, results[i])) return;
+
+        auto              start = std::chrono::steady_clock::now();
+        std::stringstream log;
+        results[i].node     = Clone(nodes_input[i]);
+        results[i].is_valid = applySchema(results[i].node, name_schema, folders_schema_, log, "", override_);
+        results[i].log      = log.str();
+        finish(start, failed, results[i]);
+    });
+
+    return results;
+}
+
+std::vector<std::string> ValidationSession::getFolderSchema() const
+{
+    return folders_schema_;
+}
+
+void ValidationSession::prefetch(const std::string& name_schema) const
+{
+    // compile all schemas before validating, otherwise the first documents would compile them concurrently
+    prefetchSchemas(name_schema, folders_schema_, override_, n_threads_).wait();
+}
+
+}  // namespace yaml_schema_cpp
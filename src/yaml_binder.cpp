@@ -0,0 +1,43 @@
+#include "yaml-schema-cpp/yaml_binder.hpp"
+
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+SchemaBinder& SchemaBinder::bindNode(const std::string& field, NodeSetter setter)
+{
+    setters_[field] = setter;
+    return *this;
+}
+
+bool SchemaBinder::isBound(const std::string& field) const
+{
+    return setters_.count(field) != 0;
+}
+
+bool SchemaBinder::assign(const std::string& field, const YAML::Node& node, std::stringstream& log) const
+{
+    auto it = setters_.find(field);
+    if (it == setters_.end()) return true;
+
+    bool assigned;
+    try
+    {
+        assigned = it->second(node);
+    }
+    catch (const std::exception& e)
+    {
+        assigned = false;
+    }
+    if (not assigned)
+        writeErrorToLog(log, field, YAML::Node(YAML::NodeType::Undefined), "Could not assign value to bound variable.");
+
+    return assigned;
+}
+
+std::size_t SchemaBinder::size() const
+{
+    return setters_.size();
+}
+
+}  // namespace yaml_schema_cpp
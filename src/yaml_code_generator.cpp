@@ -0,0 +1,107 @@
+#include <stdexcept>
+#include <iostream>
+
+#include "yaml-schema-cpp/code_generator.hpp"
+#include "yaml-schema-cpp/yaml_generator.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using namespace yaml_schema_cpp;
+
+int main(int argc, char* argv[])
+{
+    /* CALL:
+     *
+     *   yaml_code_generator schema_name schema_folders output_file namespace
+     *
+     *   'schema_name':    Schema to be compiled (just its name, without path or extension)
+     *   'schema_folders': Path to the folder(s) that contains all the schema files (they are searched recursively).
+     *                     Provide more than one folder with '[path1 path2 ...]'
+     *   'output_file':    (OPTIONAL) Path and name of the output C++ header.
+     *                     If not provided, it will be placed in $HOME with a default
+     *                     name based on schema_name (requires $HOME to be defined).
+     *   'namespace':      (OPTIONAL) Namespace of the generated code (schema_name by default).
+     *
+     *   NOTE 1: Paths can be absolute (starting by '/') or relative.
+     *   NOTE 2: 'output_file' will be overwritten if it exists.
+     */
+
+    // HELP
+    if (argc == 2 and (std::string(argv[1]) == "-h" or std::string(argv[1]) == "--help"))
+    {
+        cout << "--------- yaml_code_generator HELP ---------- \nCall it with:" << endl;
+        cout << "yaml_code_generator schema_name schema_folders output_file namespace" << endl << endl;
+        cout << "'schema_name':    Schema to be compiled (just its name, without path or extension)" << endl;
+        cout << "'schema_folders': Path to the folder(s) that contains all the schema files (they are searched "
+                "recursively)."
+             << endl;
+        cout << "                  Provide more than one folder with '[path1 path2 ...]'" << endl;
+        cout << "'output_file':    (OPTIONAL) Path and name of the output C++ header." << endl;
+        cout << "                  If not provided, it will be placed in $HOME with a default" << endl;
+        cout << "                  name based on schema_name (requires `$HOME` to be defined)." << endl;
+        cout << "'namespace':      (OPTIONAL) Namespace of the generated code (schema_name by default)." << endl
+             << endl;
+        cout << "NOTE 1: Paths can be absolute (starting by '/') or relative." << endl;
+        cout << "NOTE 2: 'output_file' will be overwritten if it exists." << endl;
+        return 0;
+    }
+    // Call
+    if (argc >= 3 and argc <= 5)
+    {
+        filesystem::path current_path(filesystem::current_path());
+
+        // Schema name
+        std::string schema(argv[1]);
+
+        // schema folders
+        std::vector<std::string> schema_folders;
+        try
+        {
+            schema_folders = parseFoldersArgument(argv[2], current_path.string());
+        }
+        catch (const std::exception& e)
+        {
+            cout << red << "ERROR: " << e.what() << reset;
+            return 1;
+        }
+
+        // default output_file
+        std::string output_file;
+        if (argc == 3)
+        {
+            if (getenv("HOME") == NULL)
+            {
+                cout << red
+                     << "ERROR: Environment variable HOME not defined (mandatory if 'output_file' not provided)."
+                     << reset;
+                return 1;
+            }
+            output_file = std::string(getenv("HOME")) + "/" + schema + ".hpp";
+        }
+        else
+            output_file = std::string(argv[3]);
+
+        // namespace
+        std::string name_space = argc == 5 ? std::string(argv[4]) : "";
+
+        // Generate code
+        try
+        {
+            output_file = generateCodeFile(output_file, schema, schema_folders, name_space);
+        }
+        catch (const std::exception& e)
+        {
+            cout << red << "ERROR: Failed to generate C++ header with error: " << e.what() << '\n' << reset;
+            return 1;
+        }
+
+        // print result and exit
+        cout << "C++ header created correctly: " << output_file << endl;
+        return 0;
+    }
+    cerr << "Wrong number of arguments, call 'yaml_code_generator --help'" << endl;
+    return 1;
+}
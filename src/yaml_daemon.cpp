@@ -0,0 +1,278 @@
+#include "yaml-schema-cpp/yaml_daemon.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "yaml-schema-cpp/yaml_diff.hpp"
+#include "yaml-schema-cpp/yaml_generator.hpp"
+#include "yaml-schema-cpp/yaml_server.hpp"
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+const std::uint32_t MAX_MESSAGE_SIZE = 1u << 30;
+
+bool sendAll(int fd, const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        auto sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 and errno == EINTR) continue;
+        if (sent <= 0) return false;
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+bool receiveAll(int fd, char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        auto received = recv(fd, data, size, 0);
+        if (received < 0 and errno == EINTR) continue;
+        if (received <= 0) return false;
+        data += received;
+        size -= received;
+    }
+    return true;
+}
+
+sockaddr_un socketAddress(const std::string& socket_path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() or socket_path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("Socket path empty or too long: '" + socket_path + "'");
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+// remove the socket left by a daemon that did not stop (throws if the path is not a socket or a daemon listens in it)
+void removeStaleSocket(const std::string& socket_path, const sockaddr_un& address)
+{
+    struct stat status;
+    if (lstat(socket_path.c_str(), &status) < 0) return;
+    if (not S_ISSOCK(status.st_mode))
+        throw std::runtime_error("YamlDaemon: '" + socket_path + "' already exists and it is not a socket");
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw std::runtime_error("YamlDaemon: could not create socket: " + std::string(strerror(errno)));
+    bool stale = connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 and
+                 errno == ECONNREFUSED;
+    close(fd);
+    if (not stale) throw std::runtime_error("YamlDaemon: socket '" + socket_path + "' already in use");
+
+    unlink(socket_path.c_str());
+}
+
+YAML::Node errorResponse(const std::string& error)
+{
+    YAML::Node response;
+    response["ok"]    = false;
+    response["error"] = error;
+    return response;
+}
+}  // namespace
+
+bool writeMessage(int fd, const std::string& message)
+{
+    if (message.size() > MAX_MESSAGE_SIZE) return false;
+
+    auto          size      = static_cast<std::uint32_t>(message.size());
+    unsigned char header[4] = {static_cast<unsigned char>(size >> 24),
+                               static_cast<unsigned char>(size >> 16),
+                               static_cast<unsigned char>(size >> 8),
+                               static_cast<unsigned char>(size)};
+    return sendAll(fd, reinterpret_cast<const char*>(header), 4) and sendAll(fd, message.data(), message.size());
+}
+
+bool readMessage(int fd, std::string& message)
+{
+    unsigned char header[4];
+    if (not receiveAll(fd, reinterpret_cast<char*>(header), 4)) return false;
+
+    std::uint32_t size = (std::uint32_t(header[0]) << 24) | (std::uint32_t(header[1]) << 16) |
+                         (std::uint32_t(header[2]) << 8) | std::uint32_t(header[3]);
+    if (size > MAX_MESSAGE_SIZE) return false;
+
+    message.resize(size);
+    return size == 0 or receiveAll(fd, &message[0], size);
+}
+
+YamlDaemon::YamlDaemon(const std::vector<std::string>& folders_schema, const std::string& socket_path, bool override)
+    : folders_schema_(folders_schema), socket_path_(socket_path), override_(override), running_(false)
+{
+}
+
+void YamlDaemon::run()
+{
+    auto address = socketAddress(socket_path_);
+    removeStaleSocket(socket_path_, address);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+        throw std::runtime_error("YamlDaemon: could not create socket: " + std::string(strerror(errno)));
+
+    if (bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 or listen(listen_fd, 16) < 0)
+    {
+        auto error = std::string(strerror(errno));
+        close(listen_fd);
+        throw std::runtime_error("YamlDaemon: could not listen in '" + socket_path_ + "': " + error);
+    }
+
+    // accept connections (polling to check running_)
+    running_ = true;
+    while (running_)
+    {
+        pollfd poll_fd{listen_fd, POLLIN, 0};
+        bool   incoming = poll(&poll_fd, 1, 100) > 0;
+
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+
+        // join the threads of closed connections
+        for (auto finished_id : finished_threads_)
+        {
+            auto it = std::find_if(
+                client_threads_.begin(), client_threads_.end(), [&](const std::thread& client_thread) {
+                    return client_thread.get_id() == finished_id;
+                });
+            it->join();
+            client_threads_.erase(it);
+        }
+        finished_threads_.clear();
+
+        if (not incoming) continue;
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) continue;
+
+        client_fds_.insert(client_fd);
+        client_threads_.emplace_back(&YamlDaemon::serve, this, client_fd);
+    }
+    close(listen_fd);
+    unlink(socket_path_.c_str());
+
+    // close connections (waiting requests are still answered)
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (auto client_fd : client_fds_) shutdown(client_fd, SHUT_RD);
+    }
+    for (auto& client_thread : client_threads_) client_thread.join();
+    client_threads_.clear();
+    finished_threads_.clear();
+}
+
+void YamlDaemon::stop()
+{
+    running_ = false;
+}
+
+void YamlDaemon::serve(int client_fd)
+{
+    std::string message;
+    while (readMessage(client_fd, message))
+    {
+        YAML::Node response;
+        try
+        {
+            response = handleRequest(YAML::Load(message));
+        }
+        catch (const std::exception& e)
+        {
+            response = errorResponse(e.what());
+        }
+        if (not writeMessage(client_fd, YAML::Dump(response))) break;
+    }
+
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    client_fds_.erase(client_fd);
+    close(client_fd);
+    finished_threads_.push_back(std::this_thread::get_id());
+}
+
+YAML::Node YamlDaemon::handleRequest(const YAML::Node& request)
+{
+    if (not request.IsMap() or not request["command"]) return errorResponse("Request without 'command'");
+    auto command = request["command"].as<std::string>();
+
+    YAML::Node response;
+    response["ok"] = true;
+    if (command == "validate")
+    {
+        YamlServer server(folders_schema_, request["input"].as<std::string>(), override_);
+        response["valid"] = server.applySchema(request["schema"].as<std::string>());
+        response["log"]   = server.getLog();
+        response["node"]  = server.getNode();
+    }
+    else if (command == "generate")
+    {
+        std::stringstream output;
+        generateTemplate(output, request["schema"].as<std::string>(), folders_schema_, override_);
+        response["template"] = output.str();
+    }
+    else if (command == "diff")
+    {
+        auto name_schema = request["schema"].as<std::string>();
+
+        YamlServer server_old(folders_schema_, request["old"].as<std::string>(), override_);
+        if (not server_old.applySchema(name_schema)) return errorResponse("'old' not valid:\n" + server_old.getLog());
+        YamlServer server_new(folders_schema_, request["new"].as<std::string>(), override_);
+        if (not server_new.applySchema(name_schema)) return errorResponse("'new' not valid:\n" + server_new.getLog());
+
+        response["diff"] = YAML::Node(YAML::NodeType::Sequence);
+        for (auto diff_entry :
+             diffNodes(server_old.getNode(), server_new.getNode(), name_schema, folders_schema_, override_))
+        {
+            YAML::Node node_entry;
+            node_entry["type"] = toString(diff_entry.diff_type);
+            node_entry["path"] = diff_entry.path;
+            if (diff_entry.old_value.IsDefined()) node_entry["old"] = diff_entry.old_value;
+            if (diff_entry.new_value.IsDefined()) node_entry["new"] = diff_entry.new_value;
+            response["diff"].push_back(node_entry);
+        }
+    }
+    else if (command == "stop")
+    {
+        stop();
+    }
+    else
+    {
+        return errorResponse("Unknown command '" + command + "'");
+    }
+    return response;
+}
+
+YAML::Node requestDaemon(const std::string& socket_path, const YAML::Node& request)
+{
+    auto address = socketAddress(socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw std::runtime_error("requestDaemon: could not create socket: " + std::string(strerror(errno)));
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        auto error = std::string(strerror(errno));
+        close(fd);
+        throw std::runtime_error("requestDaemon: could not connect to '" + socket_path + "': " + error);
+    }
+
+    std::string response;
+    bool        done = writeMessage(fd, YAML::Dump(request)) and readMessage(fd, response);
+    close(fd);
+    if (not done) throw std::runtime_error("requestDaemon: connection to '" + socket_path + "' closed");
+
+    return YAML::Load(response);
+}
+
+}  // namespace yaml_schema_cpp
@@ -0,0 +1,122 @@
+#include <fstream>
+#include <iostream>
+
+#include "yaml-schema-cpp/yaml_daemon.hpp"
+#include "yaml-schema-cpp/yaml_generator.hpp"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+
+using std::cout;
+using std::endl;
+using namespace yaml_schema_cpp;
+
+namespace
+{
+void printHelp()
+{
+    cout << "--------- yaml_daemon_client HELP ---------- \nCall it with:" << endl;
+    cout << "yaml_daemon_client socket_path validate schema_name input_file" << endl;
+    cout << "yaml_daemon_client socket_path generate schema_name [output_file]" << endl;
+    cout << "yaml_daemon_client socket_path diff schema_name old_file new_file" << endl;
+    cout << "yaml_daemon_client socket_path stop" << endl << endl;
+    cout << "'socket_path': Path of the Unix domain socket of a running yaml_validation_daemon." << endl;
+    cout << "validate:      Prints the log if the input is not valid (exit code 1)." << endl;
+    cout << "generate:      Prints the template (or writes it in 'output_file', overwritten if it exists)." << endl;
+    cout << "diff:          Prints the differences between both inputs (both have to be valid)." << endl;
+    cout << "stop:          Stops the daemon." << endl;
+}
+
+// the daemon may run in another folder
+std::string absolutePath(const std::string& path)
+{
+    return filesystem::absolute(path).string();
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    /* CALL:
+     *
+     *   yaml_daemon_client socket_path validate schema_name input_file
+     *   yaml_daemon_client socket_path generate schema_name [output_file]
+     *   yaml_daemon_client socket_path diff schema_name old_file new_file
+     *   yaml_daemon_client socket_path stop
+     *
+     *   'socket_path': Path of the Unix domain socket of a running yaml_validation_daemon.
+     */
+
+    if (argc < 3 or std::string(argv[1]) == "-h" or std::string(argv[1]) == "--help")
+    {
+        printHelp();
+        return argc == 2 ? 0 : 1;
+    }
+
+    std::string socket_path(argv[1]);
+    std::string command(argv[2]);
+
+    YAML::Node request;
+    request["command"] = command;
+    if (command == "validate" and argc == 5)
+    {
+        request["schema"] = argv[3];
+        request["input"]  = absolutePath(argv[4]);
+    }
+    else if (command == "generate" and (argc == 4 or argc == 5))
+    {
+        request["schema"] = argv[3];
+    }
+    else if (command == "diff" and argc == 6)
+    {
+        request["schema"] = argv[3];
+        request["old"]    = absolutePath(argv[4]);
+        request["new"]    = absolutePath(argv[5]);
+    }
+    else if (command != "stop" or argc != 3)
+    {
+        printHelp();
+        return 1;
+    }
+
+    YAML::Node response;
+    try
+    {
+        response = requestDaemon(socket_path, request);
+    }
+    catch (const std::exception& e)
+    {
+        cout << red << "ERROR: " << e.what() << reset << endl;
+        return 1;
+    }
+    if (not response["ok"].as<bool>())
+    {
+        cout << red << "ERROR: " << response["error"].as<std::string>() << reset << endl;
+        return 1;
+    }
+
+    if (command == "validate")
+    {
+        if (not response["valid"].as<bool>())
+        {
+            cout << response["log"].as<std::string>() << endl;
+            return 1;
+        }
+        cout << "Valid: " << request["input"].as<std::string>() << endl;
+    }
+    else if (command == "generate")
+    {
+        if (argc == 4)
+            cout << response["template"].as<std::string>();
+        else
+            std::ofstream(argv[4]) << response["template"].as<std::string>();
+    }
+    else if (command == "diff")
+    {
+        for (auto diff_entry : response["diff"])
+        {
+            cout << diff_entry["type"].as<std::string>() << " " << diff_entry["path"].as<std::string>();
+            if (diff_entry["old"]) cout << ": " << YAML::Dump(diff_entry["old"]);
+            if (diff_entry["new"]) cout << (diff_entry["old"] ? " -> " : ": ") << YAML::Dump(diff_entry["new"]);
+            cout << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "yaml-schema-cpp/yaml_diff.hpp"
+
+#include <set>
+#include <stdexcept>
+
+#include "yaml-schema-cpp/schema_cache.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+std::string childPath(const std::string& path, const std::string& key)
+{
+    return (path.empty() ? "" : path + "/") + key;
+}
+
+YAML::Node findChild(const std::unordered_map<std::string, YAML::Node>& children, const std::string& key)
+{
+    auto it = children.find(key);
+    return it == children.end() ? YAML::Node(YAML::NodeType::Undefined) : it->second;
+}
+
+// Added or removed, returns true if reported
+bool diffExistence(const YAML::Node&       node_old,
+                   const YAML::Node&       node_new,
+                   const std::string&      path,
+                   const std::string&      type,
+                   std::vector<DiffEntry>& diffs)
+{
+    if (not node_old.IsDefined() and not node_new.IsDefined()) return true;
+    if (not node_old.IsDefined())
+    {
+        diffs.push_back({DiffType::ADDED, path, type, YAML::Node(YAML::NodeType::Undefined), node_new});
+        return true;
+    }
+    if (not node_new.IsDefined())
+    {
+        diffs.push_back({DiffType::REMOVED, path, type, node_old, YAML::Node(YAML::NodeType::Undefined)});
+        return true;
+    }
+    return false;
+}
+}  // namespace
+
+std::string toString(DiffType diff_type)
+{
+    switch (diff_type)
+    {
+        case DiffType::ADDED:
+            return "added";
+        case DiffType::REMOVED:
+            return "removed";
+        case DiffType::CHANGED:
+            return "changed";
+    }
+    return "unknown";
+}
+
+std::vector<DiffEntry> diffNodes(const YAML::Node&               node_old,
+                                 const YAML::Node&               node_new,
+                                 const std::string&              name_schema,
+                                 const std::vector<std::string>& folders_schema,
+                                 bool                            override)
+{
+    std::stringstream log;
+    auto              compiled_schema = getCompiledSchema(name_schema, folders_schema, log, override);
+    if (not compiled_schema) throw std::runtime_error("diffNodes: couldn't load the schema: " + log.str());
+
+    NodeHasher             hasher;
+    std::vector<DiffEntry> diffs;
+    diffNodesSchema(node_old, node_new, compiled_schema->node, folders_schema, "", hasher, diffs);
+
+    return diffs;
+}
+
+std::vector<DiffEntry> diffNodesAutoType(const YAML::Node& node_old, const YAML::Node& node_new)
+{
+    NodeHasher             hasher;
+    std::vector<DiffEntry> diffs;
+    diffNodesAutoType(node_old, node_new, "", hasher, diffs);
+
+    return diffs;
+}
+
+void diffNodesSchema(const YAML::Node&               node_old,
+                     const YAML::Node&               node_new,
+                     const YAML::Node&               node_schema,
+                     const std::vector<std::string>& folders_schema,
+                     const std::string&              path,
+                     NodeHasher&                     hasher,
+                     std::vector<DiffEntry>&         diffs)
+{
+    // Specification
+    if (isSpecification(node_schema))
+    {
+        diffNodesType(node_old, node_new, node_schema[TYPE].as<std::string>(), folders_schema, path, hasher, diffs);
+        return;
+    }
+
+    // Map without specification (identical: the schema may have string fields, "007" != "7")
+    if (diffExistence(node_old, node_new, path, "", diffs)) return;
+    if (hasher.identical(node_old, node_new)) return;
+
+    auto                  old_children = indexMapNode(node_old);
+    auto                  new_children = indexMapNode(node_new);
+    std::set<std::string> schema_keys;
+    for (auto node_schema_child : node_schema)
+    {
+        auto key = node_schema_child.first.as<std::string>();
+        schema_keys.insert(key);
+        diffNodesSchema(findChild(old_children, key),
+                        findChild(new_children, key),
+                        node_schema_child.second,
+                        folders_schema,
+                        childPath(path, key),
+                        hasher,
+                        diffs);
+    }
+
+    // fields not specified in the schema
+    for (auto old_child : node_old)
+    {
+        auto key = old_child.first.as<std::string>();
+        if (schema_keys.count(key)) continue;
+        diffNodesAutoType(old_child.second, findChild(new_children, key), childPath(path, key), hasher, diffs);
+    }
+    for (auto new_child : node_new)
+    {
+        auto key = new_child.first.as<std::string>();
+        if (schema_keys.count(key) or old_children.count(key)) continue;
+        diffNodesAutoType(
+            YAML::Node(YAML::NodeType::Undefined), new_child.second, childPath(path, key), hasher, diffs);
+    }
+}
+
+void diffNodesType(const YAML::Node&               node_old,
+                   const YAML::Node&               node_new,
+                   const std::string&              type,
+                   const std::vector<std::string>& folders_schema,
+                   const std::string&              path,
+                   NodeHasher&                     hasher,
+                   std::vector<DiffEntry>&         diffs)
+{
+    if (diffExistence(node_old, node_new, path, type, diffs)) return;
+
+    // identical subtrees (only by text, equal values depend on the type)
+    if (hasher.identical(node_old, node_new)) return;
+
+    auto lowest_type = getLowestElementType(type);
+
+    // trivial type: typed comparison ("yes" == "true" as bool)
+    if (isTrivialType(lowest_type))
+    {
+        if (not compare(node_old, node_new, type, folders_schema))
+            diffs.push_back({DiffType::CHANGED, path, type, node_old, node_new});
+        return;
+    }
+
+    // array of custom types: element by element if same size
+    if (isArrayType(type))
+    {
+        if (not isDerivedType(type) and node_old.IsSequence() and node_new.IsSequence() and
+            node_old.size() == node_new.size())
+        {
+            for (auto i = 0; i < node_old.size(); i++)
+                diffNodesType(node_old[i],
+                              node_new[i],
+                              getLowerElementType(type),
+                              folders_schema,
+                              path + "[" + std::to_string(i) + "]",
+                              hasher,
+                              diffs);
+        }
+        else
+            diffs.push_back({DiffType::CHANGED, path, type, node_old, node_new});
+        return;
+    }
+
+    // custom type: field by field
+    std::stringstream log;
+    YAML::Node        node_schema_type;
+    if (not isDerivedType(type) and resolveTypeSchema(type, folders_schema, node_schema_type, log))
+        diffNodesSchema(node_old, node_new, node_schema_type, folders_schema, path, hasher, diffs);
+    else
+        diffs.push_back({DiffType::CHANGED, path, type, node_old, node_new});
+}
+
+void diffNodesAutoType(const YAML::Node&       node_old,
+                       const YAML::Node&       node_new,
+                       const std::string&      path,
+                       NodeHasher&             hasher,
+                       std::vector<DiffEntry>& diffs)
+{
+    if (diffExistence(node_old, node_new, path, "", diffs)) return;
+
+    // identical subtrees
+    if (hasher.equal(node_old, node_new)) return;
+
+    // maps: key by key
+    if (node_old.IsMap() and node_new.IsMap())
+    {
+        auto new_children = indexMapNode(node_new);
+        for (auto old_child : node_old)
+        {
+            auto key = old_child.first.as<std::string>();
+            diffNodesAutoType(old_child.second, findChild(new_children, key), childPath(path, key), hasher, diffs);
+        }
+        auto old_children = indexMapNode(node_old);
+        for (auto new_child : node_new)
+        {
+            auto key = new_child.first.as<std::string>();
+            if (old_children.count(key)) continue;
+            diffNodesAutoType(
+                YAML::Node(YAML::NodeType::Undefined), new_child.second, childPath(path, key), hasher, diffs);
+        }
+        return;
+    }
+
+    // sequences: element by element if same size
+    if (node_old.IsSequence() and node_new.IsSequence() and node_old.size() == node_new.size())
+    {
+        for (auto i = 0; i < node_old.size(); i++)
+            diffNodesAutoType(node_old[i], node_new[i], path + "[" + std::to_string(i) + "]", hasher, diffs);
+        return;
+    }
+
+    diffs.push_back({DiffType::CHANGED, path, "", node_old, node_new});
+}
+
+}  // namespace yaml_schema_cpp
@@ -4,6 +4,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <mutex>
 
 #include "yaml-schema-cpp/filesystem_wrapper.hpp"
 #include "yaml-schema-cpp/yaml_conversion.hpp"
@@ -11,17 +13,80 @@
 #include "yaml-schema-cpp/type_check.hpp"
 #include "yaml-schema-cpp/yaml_utils.hpp"
 #include "yaml-schema-cpp/expression.hpp"
+#include "yaml-schema-cpp/schema_cache.hpp"
 
 namespace yaml_schema_cpp
 {
 int N_SEQUENCE_OUTPUT = 2;
 
+namespace
+{
+// schema from the schema cache (throws if it cannot be loaded)
+YAML::Node cachedSchema(const std::string& name_schema, const std::vector<std::string>& folders_schema, bool override)
+{
+    std::stringstream log;
+    auto              compiled_schema = getCompiledSchema(name_schema, folders_schema, log, override);
+    if (not compiled_schema) throw std::runtime_error("Couldn't load the schema " + name_schema + ": " + log.str());
+    return compiled_schema->node;
+}
+
+// if the template of each custom type has any field (computed once per type)
+using HasTemplateMemo = std::map<std::string, bool>;
+
+// if the template of a schema node has any field (fields with VALUE are not in the template)
+bool hasTemplate(const YAML::Node&               node_schema,
+                 const std::vector<std::string>& folders_schema,
+                 bool                            override,
+                 HasTemplateMemo&                memo,
+                 size_t                          depth = 0)
+{
+    if (isSpecification(node_schema))
+    {
+        if (node_schema[VALUE]) return false;
+
+        auto lowest_type = getLowestElementType(node_schema[TYPE].as<std::string>());
+        if (isTrivialType(lowest_type) or lowest_type == "derived") return true;
+
+        auto type = getLowerElementType(node_schema[TYPE].as<std::string>(), depth);
+        if (isArrayType(type)) return hasTemplate(node_schema, folders_schema, override, memo, depth + 1);
+
+        auto memo_it = memo.find(type);
+        if (memo_it != memo.end()) return memo_it->second;
+
+        bool has_template = hasTemplate(cachedSchema(type, folders_schema, override), folders_schema, override, memo);
+        memo[type]        = has_template;
+        return has_template;
+    }
+
+    // not map: error thrown by schemaToTemplate()
+    if (not node_schema.IsMap()) return true;
+
+    for (auto node_schema_child : node_schema)
+        if (hasTemplate(node_schema_child.second, folders_schema, override, memo)) return true;
+    return false;
+}
+
+void emitTemplateValue(YAML::Emitter& emitter, const YAML::Node& node_value, bool is_string)
+{
+    if (is_string and node_value.IsScalar())
+        emitter << YAML::DoubleQuoted << node_value.Scalar();
+    else if (node_value.IsSequence())
+    {
+        // flow style only for this value (YAML::Flow would also apply to the next sequences)
+        auto node_flow = YAML::Clone(node_value);
+        node_flow.SetStyle(YAML::EmitterStyle::Flow);
+        emitter << node_flow;
+    }
+    else
+        emitter << node_value;
+}
+}  // namespace
+
 std::string generateTemplate(std::string                     filepath,
                              const std::string&              name_schema,
                              const std::vector<std::string>& folders_schema,
                              bool                            override)
 {
-    std::cout << "generateTemplate " << name_schema << std::endl;
     // Check extension
     if (filesystem::path(filepath).extension().empty())
     {
@@ -52,25 +117,22 @@ std::string generateTemplate(std::string                     filepath,
                   << reset << std::endl;
     }
 
-    // Create Template Node
-    auto template_node = generateYaml(name_schema, folders_schema);
-
-    // Modify text
-    std::stringstream template_ss;
-    template_ss << template_node;
-    // remove " "
-    std::string template_string = template_ss.str();
-    template_string.erase(std::remove(template_string.begin(), template_string.end(), '"'), template_string.end());
-    // change ' ' by " "
-    std::replace(template_string.begin(), template_string.end(), '\'', '"');
-
     // Create file
-    std::ofstream template_file;
-    template_file = std::ofstream(fp.c_str(), std::ofstream::out);  // open log file
+    std::ofstream template_file(fp.c_str(), std::ofstream::out);
     if (not template_file.is_open())
         throw std::runtime_error(std::string("Failed to open the template_file: ") + fp.c_str());
-    else
-        template_file << template_string;
+
+    // Write template (remove the file if failed)
+    try
+    {
+        generateTemplate(template_file, name_schema, folders_schema, override);
+    }
+    catch (...)
+    {
+        template_file.close();
+        filesystem::remove(fp);
+        throw;
+    }
 
     // close file
     template_file.close();
@@ -78,10 +140,76 @@ std::string generateTemplate(std::string                     filepath,
     return fp.string();
 }
 
-YAML::Node generateYaml(std::string name_schema, const std::vector<std::string>& folders_schema, bool override)
+void generateTemplate(std::ostream&                   output,
+                      const std::string&              name_schema,
+                      const std::vector<std::string>& folders_schema,
+                      bool                            override)
 {
-    std::cout << "generateYaml " << name_schema << std::endl;
+    YAML::Emitter emitter(output);
+    schemaToTemplate(cachedSchema(name_schema, folders_schema, override), emitter, folders_schema, override);
+    if (not emitter.good()) throw std::runtime_error("generateTemplate: " + emitter.GetLastError());
+    output << std::endl;
+}
 
+bool generateTemplates(const std::string&              output_folder,
+                       const std::vector<std::string>& folders_schema,
+                       std::stringstream&              log,
+                       bool                            override,
+                       unsigned int                    n_threads)
+{
+    if (not filesystem::is_directory(output_folder))
+    {
+        log << "ERROR in generateTemplates(): output folder does not exist: " << output_folder << "\n";
+        return false;
+    }
+
+    // schema names (only the first one found if repeated, see findSchema())
+    std::vector<std::string> schemas;
+    for (auto schema : getAllSchemas(folders_schema))
+        if (std::find(schemas.begin(), schemas.end(), schema) == schemas.end()) schemas.push_back(schema);
+
+    std::mutex mutex_log;
+    bool       all_generated = true;
+    parallelForEach(schemas, n_threads, [&](const std::string& schema) {
+        auto path_template =
+            (filesystem::path(output_folder) / (filesystem::path(schema).stem().string() + "_template.yaml")).string();
+        try
+        {
+            std::ofstream template_file(path_template, std::ofstream::out);
+            if (not template_file.is_open()) throw std::runtime_error("Failed to open the file " + path_template);
+            generateTemplate(template_file, schema, folders_schema, override);
+        }
+        catch (const std::exception& e)
+        {
+            filesystem::remove(path_template);
+
+            std::lock_guard<std::mutex> lock(mutex_log);
+            log << "ERROR in generateTemplates(): template of " << schema << " failed with error: " << e.what()
+                << "\n";
+            all_generated = false;
+        }
+    });
+
+    return all_generated;
+}
+
+namespace
+{
+// templates of the custom types already generated (by type and override), so that each one is generated only once
+using TemplateMemo = std::map<std::pair<std::string, bool>, YAML::Node>;
+
+void schemaToYamlMemo(const YAML::Node&               node_schema,
+                      YAML::Node&                     node_output,
+                      const std::vector<std::string>& folders_schema,
+                      bool                            override,
+                      size_t                          depth,
+                      TemplateMemo&                   memo);
+
+YAML::Node generateYamlMemo(std::string                     name_schema,
+                            const std::vector<std::string>& folders_schema,
+                            bool                            override,
+                            TemplateMemo&                   memo)
+{
     // Find schema file + check extension
     std::stringstream log;
     auto              path_schema = findSchema(name_schema, folders_schema, log);
@@ -127,18 +255,18 @@ YAML::Node generateYaml(std::string name_schema, const std::vector<std::string>&
     // Generate YAML from schema
     YAML::Node node_output;
 
-    schemaToYaml(node_schema, node_output, folders_schema, override);
+    schemaToYamlMemo(node_schema, node_output, folders_schema, override, 0, memo);
 
     return node_output;
 }
 
-void schemaToYaml(const YAML::Node&               node_schema,
-                  YAML::Node&                     node_output,
-                  const std::vector<std::string>& folders_schema,
-                  bool                            override)
+void schemaToYamlMemo(const YAML::Node&               node_schema,
+                      YAML::Node&                     node_output,
+                      const std::vector<std::string>& folders_schema,
+                      bool                            override,
+                      size_t                          depth,
+                      TemplateMemo&                   memo)
 {
-    std::cout << "schemaToYaml:\n" << node_schema << std::endl;
-
     // Specification (has _mandatory, _type and _doc)
     if (isSpecification(node_schema))
     {
@@ -196,7 +324,8 @@ void schemaToYaml(const YAML::Node&               node_schema,
         {
             // scalar
             size_t seq_size;
-            if (not isSequenceSchema(node_schema, seq_size))
+            auto   type = getLowerElementType(node_schema[TYPE].as<std::string>(), depth);
+            if (not isArrayType(type, seq_size))
             {
                 if (lowest_type == "derived")
                 {
@@ -206,34 +335,33 @@ void schemaToYaml(const YAML::Node&               node_schema,
                         node_schema[BASE].as<std::string>();
                     node_output["follow"] = "some/path/to/derived/type/parameters.yaml";
                 }
+                // already generated in this template
+                else if (memo.count({type, override}))
+                {
+                    node_output = YAML::Clone(memo.at({type, override}));
+                }
                 else if (isNonTrivialType(lowest_type, folders_schema))
                 {
                     // find trivial-type schema and apply
-                    node_output = generateYaml(node_schema[TYPE].as<std::string>(), folders_schema, override);
+                    auto node_type         = generateYamlMemo(type, folders_schema, override, memo);
+                    memo[{type, override}] = node_type;
+                    node_output            = YAML::Clone(node_type);
                 }
                 // non trivial type also failed
                 else
                 {
-                    throw std::runtime_error("Not trivial type not found: " + node_schema[TYPE].as<std::string>());
+                    throw std::runtime_error("Not trivial type not found: " + type);
                 }
             }
-            // array
+            // array (elements one level deeper, VALUE and OPTIONS not used for non-trivial types)
             else
             {
-                YAML::Node node_schema_i = Clone(node_schema);
                 if (seq_size == 0) seq_size = N_SEQUENCE_OUTPUT;
-                node_schema_i[TYPE] = getLowerElementType(node_schema[TYPE].as<std::string>());
 
                 for (auto i = 0; i < seq_size; i++)
                 {
-                    // if VALUE --> copy corresponding
-                    if (node_schema[VALUE]) node_schema_i[VALUE] = node_schema[VALUE][i];
-
-                    // if OPTIONS --> copy corresponding
-                    if (node_schema[OPTIONS]) node_schema_i[OPTIONS][0] = node_schema[OPTIONS][0][i];
-
                     YAML::Node node_output_i;
-                    schemaToYaml(node_schema_i, node_output_i, folders_schema, override);
+                    schemaToYamlMemo(node_schema, node_output_i, folders_schema, override, depth + 1, memo);
 
                     // add node if it was created (if VALUE defined, it wasn't)
                     if (not node_output_i.IsNull()) node_output.push_back(node_output_i);
@@ -250,12 +378,127 @@ void schemaToYaml(const YAML::Node&               node_schema,
         for (auto node_schema_child : node_schema)
         {
             YAML::Node node_output_child;
-            schemaToYaml(node_schema_child.second, node_output_child, folders_schema, override);
+            schemaToYamlMemo(node_schema_child.second, node_output_child, folders_schema, override, 0, memo);
 
             // add node if it was created (if VALUE defined, it wasn't)
             if (not node_output_child.IsNull()) node_output[node_schema_child.first] = node_output_child;
         }
     }
 }
+}  // namespace
+
+YAML::Node generateYaml(std::string name_schema, const std::vector<std::string>& folders_schema, bool override)
+{
+    TemplateMemo memo;
+    return generateYamlMemo(name_schema, folders_schema, override, memo);
+}
+
+void schemaToYaml(const YAML::Node&               node_schema,
+                  YAML::Node&                     node_output,
+                  const std::vector<std::string>& folders_schema,
+                  bool                            override,
+                  size_t                          depth)
+{
+    TemplateMemo memo;
+    schemaToYamlMemo(node_schema, node_output, folders_schema, override, depth, memo);
+}
+
+namespace
+{
+void schemaToTemplateMemo(const YAML::Node&               node_schema,
+                          YAML::Emitter&                  emitter,
+                          const std::vector<std::string>& folders_schema,
+                          bool                            override,
+                          size_t                          depth,
+                          HasTemplateMemo&                memo)
+{
+    // Specification (has _mandatory, _type and _doc)
+    if (isSpecification(node_schema))
+    {
+        auto type        = node_schema[TYPE].as<std::string>();
+        auto lowest_type = getLowestElementType(type);
+
+        // trivial type: value and comment
+        if (isTrivialType(lowest_type))
+        {
+            // value: default, first option or zero
+            if (node_schema[DEFAULT])
+                emitTemplateValue(emitter, node_schema[DEFAULT], isStringType(type));
+            else if (node_schema[OPTIONS])
+                emitTemplateValue(emitter, node_schema[OPTIONS][0], isStringType(type));
+            else
+                emitTemplateValue(emitter, YAML::Load(getZeroString(type)), isStringType(type));
+
+            std::string mandatory_str = isExpression(node_schema[MANDATORY])
+                                            ? "MANDATORY if " + node_schema[MANDATORY].as<std::string>() + " - "
+                                            : (node_schema[MANDATORY].as<bool>() ? "" : "OPTIONAL - ");
+            emitter << YAML::Comment(mandatory_str + "DOC " + node_schema[DOC].as<std::string>() + " - TYPE " + type +
+                                     (node_schema[OPTIONS] ? " - OPTIONS " + sequenceToString(node_schema[OPTIONS])
+                                                           : ""));
+        }
+        // custom non trivial-type or Derived type
+        else
+        {
+            auto type_depth = getLowerElementType(type, depth);
+            if (not isArrayType(type_depth))
+            {
+                if (lowest_type == "derived")
+                {
+                    emitter << YAML::BeginMap;
+                    emitter << YAML::Key << "type" << YAML::Value << YAML::DoubleQuoted << "DerivedType"
+                            << YAML::Comment("DOC String corresponding to the name of the object class (and its "
+                                             "schema file). Should be a class derived from base class: " +
+                                             node_schema[BASE].as<std::string>());
+                    emitter << YAML::Key << "follow" << YAML::Value << "some/path/to/derived/type/parameters.yaml";
+                    emitter << YAML::EndMap;
+                }
+                else
+                {
+                    schemaToTemplateMemo(
+                        cachedSchema(type_depth, folders_schema, override), emitter, folders_schema, override, 0, memo);
+                }
+            }
+            // array (elements one level deeper)
+            else
+            {
+                size_t seq_size;
+                isArrayType(type_depth, seq_size);
+                if (seq_size == 0) seq_size = N_SEQUENCE_OUTPUT;
+
+                emitter << YAML::BeginSeq;
+                for (auto i = 0; i < seq_size; i++)
+                    schemaToTemplateMemo(node_schema, emitter, folders_schema, override, depth + 1, memo);
+                emitter << YAML::EndSeq;
+            }
+        }
+    }
+    // not specification (should be a map)
+    else
+    {
+        if (not node_schema.IsMap()) throw std::runtime_error("not specification schema node should be map.");
+
+        // fields with VALUE (or only containing fields with VALUE) are not emitted
+        emitter << YAML::BeginMap;
+        for (auto node_schema_child : node_schema)
+        {
+            if (not hasTemplate(node_schema_child.second, folders_schema, override, memo)) continue;
+
+            emitter << YAML::Key << node_schema_child.first << YAML::Value;
+            schemaToTemplateMemo(node_schema_child.second, emitter, folders_schema, override, 0, memo);
+        }
+        emitter << YAML::EndMap;
+    }
+}
+}  // namespace
+
+void schemaToTemplate(const YAML::Node&               node_schema,
+                      YAML::Emitter&                  emitter,
+                      const std::vector<std::string>& folders_schema,
+                      bool                            override,
+                      size_t                          depth)
+{
+    HasTemplateMemo memo;
+    schemaToTemplateMemo(node_schema, emitter, folders_schema, override, depth, memo);
+}
 
 }  // namespace yaml_schema_cpp
@@ -0,0 +1,190 @@
+#include "yaml-schema-cpp/yaml_hash.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+const std::size_t HASH_UNDEFINED = 0x9ae16a3b2f90404fULL;
+const std::size_t HASH_NULL      = 0xc3a5c85c97cb3127ULL;
+const std::size_t HASH_SEQUENCE  = 0xb492b66fbe98f273ULL;
+const std::size_t HASH_MAP       = 0x9e3779b97f4a7c15ULL;
+
+std::size_t hashCombine(std::size_t seed, std::size_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+}  // namespace
+
+const void* nodeIdentity(const YAML::Node& node)
+{
+    // the scalar string is a member of the node data, unique for each node (even for non-scalar nodes)
+    return &node.Scalar();
+}
+
+std::unordered_map<std::string, YAML::Node> indexMapNode(const YAML::Node& node)
+{
+    std::unordered_map<std::string, YAML::Node> index;
+    if (not node.IsMap()) return index;
+
+    index.reserve(node.size());
+    for (auto child : node) index.emplace(child.first.as<std::string>(), child.second);
+
+    return index;
+}
+
+bool equalScalarsAutoType(const YAML::Node& node1, const YAML::Node& node2)
+{
+    // try as int (1e3 == 1000 but strings are not the same)
+    int int1, int2;
+    if (YAML::convert<int>::decode(node1, int1) and YAML::convert<int>::decode(node2, int2)) return int1 == int2;
+
+    // try as double (1 == 1.000 but strings are not the same)
+    double double1, double2;
+    if (YAML::convert<double>::decode(node1, double1) and YAML::convert<double>::decode(node2, double2))
+        return double1 == double2;
+
+    // try as string
+    return node1.Scalar() == node2.Scalar();
+}
+
+std::size_t hashScalarAutoType(const YAML::Node& node)
+{
+    // numbers hashed by value (all int values are exactly represented by double)
+    int    value_int;
+    double value_double;
+    if (YAML::convert<int>::decode(node, value_int))
+        value_double = value_int;
+    else if (not YAML::convert<double>::decode(node, value_double))
+        return std::hash<std::string>()(node.Scalar());
+
+    if (value_double == 0) value_double = 0;  // -0 == 0
+    return std::hash<double>()(value_double);
+}
+
+std::size_t NodeHasher::hash(const YAML::Node& node)
+{
+    return hash(node, false);
+}
+
+std::size_t NodeHasher::hash(const YAML::Node& node, bool exact)
+{
+    // keep the node memory alive, so that node identities are not reused while cached
+    // (once: a node already hashed is a pinned node or a child of one, living in its memory)
+    if (node.IsDefined() and not node.IsNull())
+    {
+        auto id = nodeIdentity(node);
+        if (not hashes_.count(id) and not exact_hashes_.count(id)) pinned_.push_back(node);
+    }
+
+    return hashRecursive(node, exact);
+}
+
+std::size_t NodeHasher::hashRecursive(const YAML::Node& node, bool exact)
+{
+    if (not node.IsDefined()) return HASH_UNDEFINED;
+    if (node.IsNull()) return HASH_NULL;
+
+    auto& hashes = exact ? exact_hashes_ : hashes_;
+    auto  id     = nodeIdentity(node);
+    auto  it     = hashes.find(id);
+    if (it != hashes.end()) return it->second;
+
+    std::size_t hash_node;
+    switch (node.Type())
+    {
+        case YAML::NodeType::Scalar:
+            hash_node = exact ? std::hash<std::string>()(node.Scalar()) : hashScalarAutoType(node);
+            break;
+        // ordered
+        case YAML::NodeType::Sequence:
+            hash_node = HASH_SEQUENCE;
+            for (auto child : node) hash_node = hashCombine(hash_node, hashRecursive(child, exact));
+            break;
+        // order independent: sum of entries
+        case YAML::NodeType::Map:
+            hash_node = HASH_MAP;
+            for (auto child : node)
+                hash_node += hashCombine(std::hash<std::string>()(child.first.as<std::string>()),
+                                         hashRecursive(child.second, exact));
+            break;
+        default:
+            hash_node = HASH_UNDEFINED;
+    }
+
+    hashes[id] = hash_node;
+    return hash_node;
+}
+
+bool NodeHasher::equal(const YAML::Node& node1, const YAML::Node& node2)
+{
+    // Different hash --> different nodes (also caches all subtree hashes)
+    if (hash(node1, false) != hash(node2, false)) return false;
+
+    return equalRecursive(node1, node2, false);
+}
+
+bool NodeHasher::identical(const YAML::Node& node1, const YAML::Node& node2)
+{
+    // Different hash --> different nodes (also caches all subtree hashes)
+    if (hash(node1, true) != hash(node2, true)) return false;
+
+    return equalRecursive(node1, node2, true);
+}
+
+bool NodeHasher::equalRecursive(const YAML::Node& node1, const YAML::Node& node2, bool exact)
+{
+    // Different types
+    if (node1.IsDefined() != node2.IsDefined() or node1.IsNull() != node2.IsNull()) return false;
+    if (node1.IsScalar() != node2.IsScalar()) return false;
+    if (node1.IsSequence() != node2.IsSequence()) return false;
+    if (node1.IsMap() != node2.IsMap()) return false;
+
+    // Different hash --> different nodes
+    if (hashRecursive(node1, exact) != hashRecursive(node2, exact)) return false;
+
+    // Null --> equal
+    if (node1.IsNull()) return true;
+
+    // Scalar --> compare
+    if (node1.IsScalar()) return exact ? node1.Scalar() == node2.Scalar() : equalScalarsAutoType(node1, node2);
+
+    // Sequence --> compare sizes & call equalRecursive
+    if (node1.IsSequence())
+    {
+        if (node1.size() != node2.size()) return false;
+
+        auto it1 = node1.begin();
+        auto it2 = node2.begin();
+        for (; it1 != node1.end(); it1++, it2++)
+            if (not equalRecursive(*it1, *it2, exact)) return false;
+
+        // all equal
+        return true;
+    }
+    // Map --> compare keys & call equalRecursive
+    if (node1.IsMap())
+    {
+        if (node1.size() != node2.size()) return false;
+
+        auto node2_children = indexMapNode(node2);
+        for (auto node1_child : node1)
+        {
+            auto node2_child = node2_children.find(node1_child.first.as<std::string>());
+            // key not found
+            if (node2_child == node2_children.end()) return false;
+            // element not equal
+            if (not equalRecursive(node1_child.second, node2_child->second, exact)) return false;
+        }
+        // all equal
+        return true;
+    }
+
+    // not map, sequence or scalar?
+    throw std::runtime_error("compareNodesAutoType: unknown node type!");
+    return false;
+}
+
+}  // namespace yaml_schema_cpp
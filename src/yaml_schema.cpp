@@ -1,9 +1,11 @@
 #include <stdexcept>
 #include <cassert>
+#include <map>
 
 #include "yaml-schema-cpp/yaml_schema.hpp"
 #include "yaml-schema-cpp/filesystem_wrapper.hpp"
 #include "yaml-schema-cpp/expression.hpp"
+#include "yaml-schema-cpp/schema_cache.hpp"
 
 namespace yaml_schema_cpp
 {
@@ -25,11 +27,31 @@ YAML::Node loadSchema(std::string                     name_schema,
     // write schema file in log
     log << "schema file found: " << path_schema << std::endl;
 
+    return loadSchemaFile(path_schema, folders_schema, log, override);
+}
+
+YAML::Node loadSchemaFile(const std::string&              path_schema,
+                          const std::vector<std::string>& folders_schema,
+                          std::stringstream&              log,
+                          bool                            override)
+{
+    std::vector<LoadedFile> loaded_files;
+    return loadSchemaFile(path_schema, folders_schema, log, override, loaded_files);
+}
+
+YAML::Node loadSchemaFile(const std::string&              path_schema,
+                          const std::vector<std::string>& folders_schema,
+                          std::stringstream&              log,
+                          bool                            override,
+                          std::vector<LoadedFile>&        loaded_files)
+{
     // Load schema yaml
     YAML::Node node_schema;
     try
     {
-        node_schema = YAML::LoadFile(path_schema);
+        LoadedFile loaded_file;
+        node_schema  = loadFile(path_schema, loaded_file);
+        loaded_files = {loaded_file};
     }
     catch (const std::exception& e)
     {
@@ -39,10 +61,19 @@ YAML::Node loadSchema(std::string                     name_schema,
     }
 
     // Flatten yaml nodes (containing "follow") to a single YAML node containing all the information
+    // (followed files loaded in parallel)
 
     try
     {
-        flattenNode(node_schema, filesystem::path(path_schema).parent_path().string(), folders_schema, true, override);
+        std::vector<LoadedFile> followed_files;
+        flattenNode(node_schema,
+                    filesystem::path(path_schema).parent_path().string(),
+                    folders_schema,
+                    true,
+                    override,
+                    true,
+                    followed_files);
+        loaded_files.insert(loaded_files.end(), followed_files.begin(), followed_files.end());
     }
     catch (const std::exception& e)
     {
@@ -132,14 +163,29 @@ void checkSchema(const YAML::Node&               node_schema,
                                      " wrong expression: " + err_msg);
         }
 
+        // resolve the type schema once, shared by the checks of value, default and options
+        YAML::Node node_schema_type(YAML::NodeType::Undefined);
+        if (node_schema[VALUE] or node_schema[DEFAULT] or node_schema[OPTIONS])
+        {
+            std::stringstream log;
+            if (not resolveTypeSchema(getCheckType(node_schema), folders_schema, node_schema_type, log))
+            {
+                throw std::runtime_error("YAML schema: " + node_field + ", couldn't load the schema of its " + TYPE +
+                                         " with error: " + log.str());
+            }
+        }
+
         // check value (optional)
-        if (node_schema[VALUE]) checkSchemaValue(node_schema, node_field, node_schema_parent, folders_schema);
+        if (node_schema[VALUE])
+            checkSchemaValue(node_schema, node_field, node_schema_parent, node_schema_type, folders_schema);
 
         // check default (optional)
-        if (node_schema[DEFAULT]) checkSchemaDefault(node_schema, node_field, node_schema_parent, folders_schema);
+        if (node_schema[DEFAULT])
+            checkSchemaDefault(node_schema, node_field, node_schema_parent, node_schema_type, folders_schema);
 
         // check options (optional)
-        if (node_schema[OPTIONS]) checkSchemaOptions(node_schema, node_field, node_schema_parent, folders_schema);
+        if (node_schema[OPTIONS])
+            checkSchemaOptions(node_schema, node_field, node_schema_parent, node_schema_type, folders_schema);
     }
     // no specifications
     else
@@ -168,12 +214,28 @@ void checkSchemaValue(const YAML::Node&               node_schema,
                       const std::string&              node_field,
                       const YAML::Node&               node_schema_parent,
                       const std::vector<std::string>& folders_schema)
+{
+    YAML::Node        node_schema_type;
+    std::stringstream log;
+    if (not resolveTypeSchema(getCheckType(node_schema), folders_schema, node_schema_type, log))
+    {
+        throw std::runtime_error("YAML schema: " + node_field + ", " + VALUE +
+                                 " did not pass the schema check with error: " + log.str());
+    }
+    checkSchemaValue(node_schema, node_field, node_schema_parent, node_schema_type, folders_schema);
+}
+
+void checkSchemaValue(const YAML::Node&               node_schema,
+                      const std::string&              node_field,
+                      const YAML::Node&               node_schema_parent,
+                      const YAML::Node&               node_schema_type,
+                      const std::vector<std::string>& folders_schema)
 {
     // Check VALUE follows the corresponding schema
     std::string       type = getCheckType(node_schema);  // If derived type take BASE
     std::stringstream log;
     YAML::Node        node_schema_value = node_schema[VALUE];
-    if (not applySchema(node_schema_value, type, folders_schema, log, ""))
+    if (not applySchemaResolved(node_schema_value, type, node_schema_type, folders_schema, log, "", true))
     {
         throw std::runtime_error("YAML schema: " + node_field + ", " + VALUE +
                                  " did not pass the schema check with error: " + log.str());
@@ -192,6 +254,22 @@ void checkSchemaDefault(const YAML::Node&               node_schema,
                         const std::string&              node_field,
                         const YAML::Node&               node_schema_parent,
                         const std::vector<std::string>& folders_schema)
+{
+    YAML::Node        node_schema_type;
+    std::stringstream log;
+    if (not resolveTypeSchema(getCheckType(node_schema), folders_schema, node_schema_type, log))
+    {
+        throw std::runtime_error("YAML schema: " + node_field + ", " + DEFAULT +
+                                 " did not pass the schema check with error: " + log.str());
+    }
+    checkSchemaDefault(node_schema, node_field, node_schema_parent, node_schema_type, folders_schema);
+}
+
+void checkSchemaDefault(const YAML::Node&               node_schema,
+                        const std::string&              node_field,
+                        const YAML::Node&               node_schema_parent,
+                        const YAML::Node&               node_schema_type,
+                        const std::vector<std::string>& folders_schema)
 {
     // Check not mandatory
     if (not isExpression(node_schema[MANDATORY]) and node_schema[MANDATORY].as<bool>())
@@ -204,7 +282,7 @@ void checkSchemaDefault(const YAML::Node&               node_schema,
     std::string       type = getCheckType(node_schema);  // If derived type take BASE
     std::stringstream log;
     YAML::Node        node_schema_default = node_schema[DEFAULT];
-    if (not applySchema(node_schema_default, type, folders_schema, log, ""))
+    if (not applySchemaResolved(node_schema_default, type, node_schema_type, folders_schema, log, "", true))
     {
         throw std::runtime_error("YAML schema: " + node_field + ", " + DEFAULT +
                                  " did not pass the schema check with error: " + log.str());
@@ -215,6 +293,22 @@ void checkSchemaOptions(const YAML::Node&               node_schema,
                         const std::string&              node_field,
                         const YAML::Node&               node_schema_parent,
                         const std::vector<std::string>& folders_schema)
+{
+    YAML::Node        node_schema_type;
+    std::stringstream log;
+    if (not resolveTypeSchema(getCheckType(node_schema), folders_schema, node_schema_type, log))
+    {
+        throw std::runtime_error("YAML schema: " + node_field + ", " + OPTIONS +
+                                 " did not pass the schema check with error: " + log.str());
+    }
+    checkSchemaOptions(node_schema, node_field, node_schema_parent, node_schema_type, folders_schema);
+}
+
+void checkSchemaOptions(const YAML::Node&               node_schema,
+                        const std::string&              node_field,
+                        const YAML::Node&               node_schema_parent,
+                        const YAML::Node&               node_schema_type,
+                        const std::vector<std::string>& folders_schema)
 {
     // Check that it is a sequence
     if (not node_schema[OPTIONS].IsSequence())
@@ -223,12 +317,19 @@ void checkSchemaOptions(const YAML::Node&               node_schema,
     }
 
     // Check options against corresponding schema (if "derived" --> BASE)
-    std::string type = getCheckType(node_schema);  // If derived type take BASE
+    // Repeated options are only validated once (memoized by their emitted text)
+    std::string                 type = getCheckType(node_schema);  // If derived type take BASE
+    std::map<std::string, bool> options_checked;
     for (auto n_i = 0; n_i < node_schema[OPTIONS].size(); n_i++)
     {
+        YAML::Node  node_schema_option_i = node_schema[OPTIONS][n_i];
+        std::string option_str           = YAML::Dump(node_schema_option_i);
+        if (options_checked.count(option_str)) continue;
+
         std::stringstream log;
-        YAML::Node        node_schema_option_i = node_schema[OPTIONS][n_i];
-        if (not applySchema(node_schema_option_i, type, folders_schema, log, ""))
+        options_checked[option_str] =
+            applySchemaResolved(node_schema_option_i, type, node_schema_type, folders_schema, log, "", true);
+        if (not options_checked[option_str])
         {
             throw std::runtime_error("YAML schema: " + node_field + ", " + DEFAULT +
                                      " did not pass the schema check with error: " + log.str());
@@ -238,7 +339,7 @@ void checkSchemaOptions(const YAML::Node&               node_schema,
     // If default, check it is included in options
     if (node_schema[DEFAULT])
     {
-        if (not isInOptions(node_schema[DEFAULT], node_schema[OPTIONS], type, folders_schema))
+        if (not isInOptionsResolved(node_schema[DEFAULT], node_schema[OPTIONS], type, node_schema_type, folders_schema))
         {
             throw std::runtime_error("YAML schema: " + node_field + ", " + DEFAULT +
                                      " value should be one of the specified in " + OPTIONS);
@@ -247,7 +348,7 @@ void checkSchemaOptions(const YAML::Node&               node_schema,
     // If value, check it is included in options
     if (node_schema[VALUE])
     {
-        if (not isInOptions(node_schema[VALUE], node_schema[OPTIONS], type, folders_schema))
+        if (not isInOptionsResolved(node_schema[VALUE], node_schema[OPTIONS], type, node_schema_type, folders_schema))
         {
             throw std::runtime_error("YAML schema: " + node_field + ", " + VALUE +
                                      " value should be one of the specified in " + OPTIONS);
@@ -332,9 +433,61 @@ bool applySchema(YAML::Node&                     node_input,
                  const std::vector<std::string>& folders,
                  std::stringstream&              log,
                  const std::string&              acc_field,
-                 bool                            override)
+                 bool                            override,
+                 const SchemaBinder*             binder)
+{
+    return applySchemaResolved(
+        node_input, type, YAML::Node(YAML::NodeType::Undefined), folders, log, acc_field, override, binder);
+}
+
+bool resolveTypeSchema(const std::string&              type,
+                       const std::vector<std::string>& folders,
+                       YAML::Node&                     node_schema_type,
+                       std::stringstream&              log,
+                       bool                            override)
+{
+    std::shared_ptr<const CompiledSchema> compiled_schema_type;
+    return resolveTypeSchema(type, folders, node_schema_type, compiled_schema_type, log, override);
+}
+
+bool resolveTypeSchema(const std::string&                     type,
+                       const std::vector<std::string>&        folders,
+                       YAML::Node&                            node_schema_type,
+                       std::shared_ptr<const CompiledSchema>& compiled_schema_type,
+                       std::stringstream&                     log,
+                       bool                                   override)
+{
+    auto lowest_type = getLowestElementType(type);
+
+    // trivial types do not have schema
+    if (isTrivialType(lowest_type))
+    {
+        compiled_schema_type = nullptr;
+        node_schema_type.reset(YAML::Node(YAML::NodeType::Undefined));
+        return true;
+    }
+
+    compiled_schema_type = getCompiledSchema(lowest_type, folders, log, override);
+    if (not compiled_schema_type)
+    {
+        node_schema_type.reset(YAML::Node(YAML::NodeType::Undefined));
+        return false;
+    }
+    node_schema_type.reset(compiled_schema_type->node);
+    return true;
+}
+
+bool applySchemaResolved(YAML::Node&                     node_input,
+                         const std::string&              type,
+                         const YAML::Node&               node_schema_type,
+                         const std::vector<std::string>& folders,
+                         std::stringstream&              log,
+                         const std::string&              acc_field,
+                         bool                            override,
+                         const SchemaBinder*             binder,
+                         const CompiledSchema*           compiled_schema_type)
 {
-    // Array type --> recursive call to applySchema
+    // Array type --> recursive call to applySchemaResolved
     size_t size;
     if (isArrayType(type, size))
     {
@@ -355,16 +508,19 @@ bool applySchema(YAML::Node&                     node_input,
             is_valid = false;
         }
 
-        // applySchema recursively for all nodes in sequence
+        // applySchemaResolved recursively for all nodes in sequence
         for (auto i = 0; i < node_input.size(); i++)
         {
             YAML::Node node_input_i = node_input[i];
-            is_valid                = applySchema(node_input_i,
-                                   getLowerElementType(type),
-                                   folders,
-                                   log,
-                                   acc_field + "[" + std::to_string(i) + "]",
-                                   override) and
+            is_valid                = applySchemaResolved(node_input_i,
+                                           getLowerElementType(type),
+                                           node_schema_type,
+                                           folders,
+                                           log,
+                                           acc_field + "[" + std::to_string(i) + "]",
+                                           override,
+                                           binder,
+                                           compiled_schema_type) and
                        is_valid;
         }
         return is_valid;
@@ -384,14 +540,33 @@ bool applySchema(YAML::Node&                     node_input,
             else
                 return true;
         }
-        // Non-trivial: Load and apply schema
+        // Non-trivial: apply the resolved schema (get it from the schema cache if not resolved yet)
         else
         {
-            YAML::Node node_schema = loadSchema(type, folders, log, override);
-            if (not node_schema.IsDefined()) return false;
+            if (node_schema_type.IsDefined())
+                return applySchemaRecursive(node_input,
+                                            node_input,
+                                            node_schema_type,
+                                            folders,
+                                            log,
+                                            acc_field,
+                                            override,
+                                            binder,
+                                            compiled_schema_type);
+
+            auto compiled_schema = getCompiledSchema(type, folders, log, override);
+            if (not compiled_schema) return false;
 
             // Check node_input against node_schema
-            return applySchemaRecursive(node_input, node_input, node_schema, folders, log, acc_field, override);
+            return applySchemaRecursive(node_input,
+                                        node_input,
+                                        compiled_schema->node,
+                                        folders,
+                                        log,
+                                        acc_field,
+                                        override,
+                                        binder,
+                                        compiled_schema.get());
         }
     }
 }
@@ -402,7 +577,9 @@ bool applySchemaRecursive(YAML::Node&                     node_input,
                           const std::vector<std::string>& folders,
                           std::stringstream&              log,
                           const std::string&              acc_field,
-                          bool                            override)
+                          bool                            override,
+                          const SchemaBinder*             binder,
+                          const CompiledSchema*           compiled_schema)
 {
     bool is_valid = true;
 
@@ -426,8 +603,14 @@ bool applySchemaRecursive(YAML::Node&                     node_input,
             // Derived type ( "derived" or "derived[]" or "derived[][]".. )
             if (isDerivedType(node_schema[TYPE].as<std::string>()))
             {
-                is_valid = applySchemaDerived(
-                               node_input, node_input_parent, node_schema, folders, log, acc_field, override) and
+                is_valid = applySchemaDerived(node_input,
+                                              node_input_parent,
+                                              node_schema,
+                                              folders,
+                                              log,
+                                              acc_field,
+                                              override,
+                                              binder) and
                            is_valid;
             }
             // Type specified (either trivial or custom)
@@ -435,15 +618,20 @@ bool applySchemaRecursive(YAML::Node&                     node_input,
             {
                 // check with corresponding schema file or trivial type
                 if (not applySchema(
-                        node_input, node_schema[TYPE].as<std::string>(), folders, log, acc_field, override))
+                        node_input, node_schema[TYPE].as<std::string>(), folders, log, acc_field, override, binder))
                 {
                     is_valid = false;
                 }
                 // check if value is in OPTIONS (only if passed schema validation)
+                // (using the options normalized when compiling the schema if available)
                 else if (node_schema[OPTIONS])
                 {
-                    if (not isInOptions(
-                            node_input, node_schema[OPTIONS], node_schema[TYPE].as<std::string>(), folders))
+                    auto options_set = compiled_schema ? compiled_schema->findOptions(node_schema[OPTIONS]) : nullptr;
+                    if (options_set ? not options_set->contains(node_input)
+                                    : not isInOptions(node_input,
+                                                      node_schema[OPTIONS],
+                                                      node_schema[TYPE].as<std::string>(),
+                                                      folders))
                     {
                         writeErrorToLog(
                             log, acc_field, node_schema, "Wrong value. Allowed values defined in OPTIONS.");
@@ -451,6 +639,9 @@ bool applySchemaRecursive(YAML::Node&                     node_input,
                     }
                 }
             }
+
+            // assign bound variable (if valid)
+            if (binder and is_valid) is_valid = binder->assign(acc_field, node_input, log);
         }
         // Does not exist -> check if MANDATORY (add DEFAULT) or add VALUE
         else
@@ -464,6 +655,7 @@ bool applySchemaRecursive(YAML::Node&                     node_input,
                     auto field               = filesystem::path(acc_field).filename().string();
                     node_input_parent[field] = Clone(node_schema[VALUE]);
                 }
+                if (binder) is_valid = binder->assign(acc_field, node_schema[VALUE], log) and is_valid;
             }
             // Check if it is mandatory
             else
@@ -507,6 +699,8 @@ bool applySchemaRecursive(YAML::Node&                     node_input,
                     }
                     auto field               = filesystem::path(acc_field).filename().string();
                     node_input_parent[field] = Clone(node_schema[DEFAULT]);
+
+                    if (binder) is_valid = binder->assign(acc_field, node_schema[DEFAULT], log) and is_valid;
                 }
             }
         }
@@ -534,7 +728,9 @@ bool applySchemaRecursive(YAML::Node&                     node_input,
                            folders,
                            log,
                            (acc_field.empty() ? "" : acc_field + "/") + node_schema_child.first.as<std::string>(),
-                           override) and
+                           override,
+                           binder,
+                           compiled_schema) and
                        is_valid;
         }
     }
@@ -548,13 +744,15 @@ bool applySchemaDerived(YAML::Node&                     node_input,
                         const std::vector<std::string>& folders,
                         std::stringstream&              log,
                         const std::string&              acc_field,
-                        bool                            override)
+                        bool                            override,
+                        const SchemaBinder*             binder,
+                        size_t                          depth)
 {
     bool is_valid = true;
 
     // array
     size_t size;
-    if (isArrayType(node_schema[TYPE].as<std::string>(), size))
+    if (isArrayType(getLowerElementType(node_schema[TYPE].as<std::string>(), depth), size))
     {
         // If node not sequence complain
         if (not node_input.IsSequence())
@@ -571,19 +769,19 @@ bool applySchemaDerived(YAML::Node&                     node_input,
                             " wrong size, should be " + std::to_string(size));
             is_valid = false;
         }
-        // applySchemaDerived recursively for all nodes in sequence
-        YAML::Node node_schema_i = YAML::Clone(node_schema);
-        node_schema_i[TYPE]      = getLowerElementType(node_schema[TYPE].as<std::string>());
+        // applySchemaDerived recursively for all nodes in sequence (one level deeper)
         for (auto i = 0; i < node_input.size(); i++)
         {
             YAML::Node node_input_i = node_input[i];
             is_valid                = applySchemaDerived(node_input_i,
                                           node_input_parent,
-                                          node_schema_i,
+                                          node_schema,
                                           folders,
                                           log,
                                           acc_field + "[" + std::to_string(i) + "]",
-                                          override) and
+                                          override,
+                                          binder,
+                                          depth + 1) and
                        is_valid;
         }
         return is_valid;
@@ -599,11 +797,13 @@ bool applySchemaDerived(YAML::Node&                     node_input,
         }
 
         // Validate with derived schema file
-        is_valid = applySchema(node_input, node_input["type"].as<std::string>(), folders, log, acc_field, override) and
+        is_valid = applySchema(
+                       node_input, node_input["type"].as<std::string>(), folders, log, acc_field, override, binder) and
                    is_valid;
 
         // Validate with base schema file (after derived since it may complete the input node)
-        is_valid = applySchema(node_input, node_schema[BASE].as<std::string>(), folders, log, acc_field, override) and
+        is_valid = applySchema(
+                       node_input, node_schema[BASE].as<std::string>(), folders, log, acc_field, override, binder) and
                    is_valid;
 
         return is_valid;
@@ -614,10 +814,20 @@ bool isInOptions(const YAML::Node&               input_node,
                  const YAML::Node&               options_node,
                  const std::string&              type,
                  const std::vector<std::string>& folders_schema)
+{
+    return isInOptionsResolved(
+        input_node, options_node, type, YAML::Node(YAML::NodeType::Undefined), folders_schema);
+}
+
+bool isInOptionsResolved(const YAML::Node&               input_node,
+                         const YAML::Node&               options_node,
+                         const std::string&              type,
+                         const YAML::Node&               node_schema_type,
+                         const std::vector<std::string>& folders_schema)
 {
     for (auto option_n : options_node)
     {
-        if (compare(option_n, input_node, type, folders_schema))
+        if (compareResolved(option_n, input_node, type, node_schema_type, folders_schema))
         {
             return true;
         }
@@ -665,15 +875,10 @@ void addNodeSchema(YAML::Node&        node,
     }
 
     // relative path input case
-    if (node[key].Type() == YAML::NodeType::Scalar)
+    if (node[key].IsScalar() and isRelativePathPrefix(node[key].Scalar()))
     {
-        std::string value_str = node[key].as<std::string>();
-        if ((value_str.size() > 1 and value_str.substr(0, 2) == "./") or
-            (value_str.size() > 2 and value_str.substr(0, 3) == "../"))
-        {
-            filesystem::path path_value = filesystem::path(parent_path) / filesystem::path(value.as<std::string>());
-            node[key]                   = path_value.string();
-        }
+        filesystem::path path_value = filesystem::path(parent_path) / filesystem::path(value.as<std::string>());
+        node[key]                   = path_value.string();
     }
 }
 
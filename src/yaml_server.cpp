@@ -2,99 +2,225 @@
 
 #include <stdexcept>
 #include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/validation_cache.hpp"
 #include "yaml-schema-cpp/yaml_schema.hpp"
 #include "yaml-schema-cpp/yaml_utils.hpp"
 
 namespace yaml_schema_cpp
 {
 
-YamlServer::YamlServer(bool override) : folders_schema_(), path_input_(), override_(override) {}
+YamlServer::YamlServer(bool override) : state_(std::make_shared<const State>()), override_(override) {}
 
-YamlServer::YamlServer(const std::vector<std::string>& folders_schema, bool override)
-    : folders_schema_(folders_schema), override_(override)
+YamlServer::YamlServer(const std::vector<std::string>& folders_schema, bool override) : override_(override)
 {
+    auto state            = std::make_shared<State>();
+    state->folders_schema = folders_schema;
+    state_                = state;
 }
 
 YamlServer::YamlServer(const std::vector<std::string>& folders_schema, const std::string& path_input, bool override)
-    : folders_schema_(folders_schema), override_(override)
+    : YamlServer(folders_schema, override)
 {
     loadYaml(path_input);
 }
 
+YamlServer::YamlServer(YamlServer&& other) : state_(other.getState()), override_(other.override_) {}
+
 void YamlServer::addFolderSchema(const std::vector<std::string>& folders_schema, bool before)
 {
-    folders_schema_.insert(
-        before ? folders_schema_.begin() : folders_schema_.end(), folders_schema.begin(), folders_schema.end());
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    auto state = std::make_shared<State>(*getState());
+    state->folders_schema.insert(before ? state->folders_schema.begin() : state->folders_schema.end(),
+                                 folders_schema.begin(),
+                                 folders_schema.end());
+    setState(state);
 }
 
 void YamlServer::addFolderSchema(const std::string& folder_schema, bool before)
 {
-    folders_schema_.insert(before ? folders_schema_.begin() : folders_schema_.end(), folder_schema);
+    addFolderSchema(std::vector<std::string>{folder_schema}, before);
 }
 
 std::vector<std::string> YamlServer::getFolderSchema() const
 {
-    return folders_schema_;
+    return getState()->folders_schema;
 }
 
 void YamlServer::loadYaml(const std::string& path_input)
 {
-    // Check file exists
-    if (not filesystem::exists(path_input))
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    auto                    state = std::make_shared<State>(*getState());
+    std::vector<LoadedFile> loaded_files;
+    load(*state, path_input, loaded_files);
+    setState(state);
+}
+
+void YamlServer::setYaml(const YAML::Node _node_input)
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    auto state = std::make_shared<State>(*getState());
+    state->node_input.reset(Clone(_node_input));
+    setState(state);
+}
+
+bool YamlServer::applySchema(const std::string& name_schema)
+{
+    return applySchema(name_schema, nullptr);
+}
+
+bool YamlServer::applySchema(const std::string& name_schema, const SchemaBinder& binder)
+{
+    return applySchema(name_schema, &binder);
+}
+
+bool YamlServer::applySchema(const std::string& name_schema, const SchemaBinder* binder)
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    // validate a copy, so that readers can still use the current state meanwhile
+    // (reset, not assign: assigning would overwrite the node still shared with the published state)
+    auto state = std::make_shared<State>(*getState());
+    state->node_input.reset(Clone(state->node_input));
+
+    bool is_valid = validate(*state, name_schema, binder);
+    setState(state);
+
+    return is_valid;
+}
+
+bool YamlServer::loadAndApplySchema(const std::string& path_input, const std::string& name_schema)
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    auto state = std::make_shared<State>(*getState());
+
+    // cached result
+    std::string fingerprint;
+    if (not state->cache_folder.empty())
     {
-        throw std::runtime_error("YAML file does not exists. Non-existing path: " + path_input);
+        fingerprint = validationFingerprint(path_input, name_schema, state->folders_schema, override_);
+
+        CachedValidation cached;
+        if (loadCachedValidation(state->cache_folder, fingerprint, cached))
+        {
+            state->path_input = path_input;
+            state->node_input.reset(cached.node);
+            state->log        = cached.log;
+            setState(state);
+            return cached.is_valid;
+        }
     }
 
-    // load yamlfile
-    path_input_ = path_input;
-    node_input_ = YAML::LoadFile(path_input);
+    std::vector<LoadedFile> loaded_files;
+    load(*state, path_input, loaded_files);
+    bool is_valid = validate(*state, name_schema, nullptr);
 
-    // flatten
-    flattenNode(node_input_, filesystem::path(path_input).parent_path().string(), {}, false, override_);
+    if (not state->cache_folder.empty())
+        storeCachedValidation(
+            state->cache_folder, fingerprint, loaded_files, CachedValidation{is_valid, state->log, state->node_input});
+
+    setState(state);
+
+    return is_valid;
 }
 
-void YamlServer::setYaml(const YAML::Node _node_input)
+void YamlServer::setValidationCache(const std::string& cache_folder)
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    auto state          = std::make_shared<State>(*getState());
+    state->cache_folder = cache_folder;
+    setState(state);
+}
+
+std::string YamlServer::getValidationCache() const
 {
-    node_input_ = Clone(_node_input);
+    return getState()->cache_folder;
 }
 
-bool YamlServer::applySchema(const std::string& name_schema)
+std::string YamlServer::getLog() const
+{
+    return getState()->log;
+}
+
+YAML::Node YamlServer::getNode() const
+{
+    return Clone(getState()->node_input);
+}
+
+void YamlServer::load(State& state, const std::string& path_input, std::vector<LoadedFile>& loaded_files) const
 {
-    log_.str("");
-    log_.clear();
-    std::string header1, header2, header3;
+    // Check file exists
+    if (not filesystem::exists(path_input))
+    {
+        throw std::runtime_error("YAML file does not exists. Non-existing path: " + path_input);
+    }
+
+    // load yamlfile
+    LoadedFile loaded_file;
+    state.path_input = path_input;
+    state.node_input.reset(loadFile(path_input, loaded_file));
+
+    // flatten (followed files loaded in parallel)
+    std::vector<LoadedFile> followed_files;
+    flattenNode(state.node_input,
+                filesystem::path(path_input).parent_path().string(),
+                {},
+                false,
+                override_,
+                true,
+                followed_files);
+
+    loaded_files = {loaded_file};
+    loaded_files.insert(loaded_files.end(), followed_files.begin(), followed_files.end());
+}
+
+bool YamlServer::validate(State& state, const std::string& name_schema, const SchemaBinder* binder) const
+{
+    std::stringstream log;
+    std::string       header1, header2, header3;
 
     header1 = "LOG OUTPUT OF applySchema";
-    if (path_input_.empty())
+    if (state.path_input.empty())
         header2 = "  yaml node added via setYaml";
     else
-        header2 = "  yaml file: " + path_input_;
+        header2 = "  yaml file: " + state.path_input;
     header3 = "  schema: " + name_schema;
     std::stringstream header4ss;
     header4ss << "  folders_schema: ";
-    for (auto folder : folders_schema_) header4ss << folder << ", ";
+    for (auto folder : state.folders_schema) header4ss << folder << ", ";
 
     auto max_size = std::max({header1.size(), header2.size(), header3.size(), header4ss.str().size()});
 
-    log_ << std::endl;
-    log_ << std::string(max_size, '-') << std::endl;
-    log_ << header1 << std::endl;
-    log_ << header2 << std::endl;
-    log_ << header3 << std::endl;
-    log_ << header4ss.str() << std::endl;
-    log_ << std::string(max_size, '-') << std::endl << std::endl;
+    log << std::endl;
+    log << std::string(max_size, '-') << std::endl;
+    log << header1 << std::endl;
+    log << header2 << std::endl;
+    log << header3 << std::endl;
+    log << header4ss.str() << std::endl;
+    log << std::string(max_size, '-') << std::endl << std::endl;
+
+    bool is_valid =
+        yaml_schema_cpp::applySchema(state.node_input, name_schema, state.folders_schema, log, "", override_, binder);
 
-    return yaml_schema_cpp::applySchema(node_input_, name_schema, folders_schema_, log_, "", override_);
+    state.log = log.str();
+
+    return is_valid;
 }
 
-std::string YamlServer::getLog() const
+std::shared_ptr<const YamlServer::State> YamlServer::getState() const
 {
-    return log_.str();
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return state_;
 }
 
-YAML::Node YamlServer::getNode() const
+void YamlServer::setState(const std::shared_ptr<const State>& state)
 {
-    return Clone(node_input_);
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    state_ = state;
 }
 
 }  // namespace yaml_schema_cpp
@@ -0,0 +1,522 @@
+#include "yaml-schema-cpp/yaml_stream.hpp"
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#include "yaml-cpp/eventhandler.h"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/schema_cache.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+
+namespace yaml_schema_cpp
+{
+namespace
+{
+// the document cannot be validated while parsing, it has to be loaded
+struct StreamFallback : public std::runtime_error
+{
+    StreamFallback(const std::string& what) : std::runtime_error(what) {}
+};
+
+struct Frame
+{
+    enum Kind
+    {
+        MAP,       // map of the schema, its fields are validated as they arrive
+        ELEMENTS,  // sequence of a field of array type, its elements are validated as they arrive
+        CAPTURE,   // map or sequence materialized to be validated when completed
+        SKIP       // not in the schema
+    };
+    Kind        kind;
+    std::string path;
+    YAML::Node  node_schema;  // MAP: schema of the map, ELEMENTS: specification of the field
+    YAML::Node  node;         // MAP: stored fields, ELEMENTS: stored elements, CAPTURE: the materialized node
+    bool        keep;         // node has to be stored in the parent
+
+    // MAP and CAPTURE (map)
+    bool                  has_key = false;
+    std::string           key;
+    YAML::Node            key_node;
+    std::set<std::string> seen;
+
+    // ELEMENTS
+    std::string                           element_type;
+    YAML::Node                            node_schema_type;
+    std::shared_ptr<const CompiledSchema> compiled_schema_type;
+    size_t                                size  = 0;
+    size_t                                count = 0;
+};
+
+class StreamValidator : public YAML::EventHandler
+{
+  public:
+    StreamValidator(const CompiledSchema&           compiled_schema,
+                    const std::string&              current_folder,
+                    const std::vector<std::string>& folders_schema,
+                    std::stringstream&              log,
+                    const std::vector<std::string>& keep,
+                    bool                            override)
+        : compiled_schema_(compiled_schema),
+          node_schema_(compiled_schema.node),
+          current_folder_(current_folder),
+          folders_schema_(folders_schema),
+          log_(log),
+          keep_(keep),
+          override_(override),
+          is_valid_(true),
+          done_(false)
+    {
+    }
+
+    bool isValid() const
+    {
+        return is_valid_;
+    }
+    bool isDone() const
+    {
+        return done_;
+    }
+    const YAML::Node& getNode() const
+    {
+        return node_;
+    }
+
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+
+    void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override
+    {
+        complete(YAML::Node(YAML::NodeType::Null), anchor);
+    }
+
+    void OnAlias(const YAML::Mark&, YAML::anchor_t anchor) override
+    {
+        auto it = anchors_.find(anchor);
+        if (it == anchors_.end()) throw StreamFallback("alias of a streamed node");
+        complete(it->second, YAML::NullAnchor);
+    }
+
+    void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override
+    {
+        YAML::Node node(value);
+        node.SetTag(tag);
+        complete(node, anchor);
+    }
+
+    void OnSequenceStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value)
+        override
+    {
+        begin(false, anchor);
+    }
+
+    void OnSequenceEnd() override
+    {
+        end();
+    }
+
+    void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override
+    {
+        begin(true, anchor);
+    }
+
+    void OnMapEnd() override
+    {
+        end();
+    }
+
+  private:
+    std::string childPath(const Frame& frame) const
+    {
+        return (frame.path.empty() ? "" : frame.path + "/") + frame.key;
+    }
+
+    // path is kept or contains kept fields
+    bool isNeeded(const std::string& path) const
+    {
+        for (auto& keep_path : keep_)
+            if (keep_path == path or keep_path.compare(0, path.size() + 1, path + "/") == 0) return true;
+        return false;
+    }
+
+    bool isKept(const Frame& frame, const std::string& path) const
+    {
+        for (auto& keep_path : keep_)
+            if (keep_path == path) return true;
+        return frame.keep;
+    }
+
+    // relative path input case (see addNodeYaml())
+    YAML::Node resolveRelativePath(const YAML::Node& value) const
+    {
+        if (current_folder_.empty() or not value.IsScalar() or not isRelativePathPrefix(value.Scalar())) return value;
+        return YAML::Node((filesystem::path(current_folder_) / filesystem::path(value.Scalar())).string());
+    }
+
+    void push(Frame::Kind kind, const std::string& path, const YAML::Node& node_schema, bool keep, bool is_map)
+    {
+        Frame frame;
+        frame.kind        = kind;
+        frame.path        = path;
+        frame.node_schema = node_schema;
+        frame.keep        = keep;
+        if (kind == Frame::CAPTURE or kind == Frame::ELEMENTS)
+            frame.node = YAML::Node(is_map ? YAML::NodeType::Map : YAML::NodeType::Sequence);
+        frames_.push_back(frame);
+    }
+
+    // beginning of a map or a sequence
+    void begin(bool is_map, YAML::anchor_t anchor)
+    {
+        // root
+        if (frames_.empty())
+        {
+            if (not is_map or isSpecification(node_schema_)) throw StreamFallback("root is not a map");
+            push(Frame::MAP, "", node_schema_, false, true);
+            return;
+        }
+
+        Frame& top = frames_.back();
+        switch (top.kind)
+        {
+            case Frame::SKIP:
+                push(Frame::SKIP, top.path, YAML::Node(), false, is_map);
+                return;
+            case Frame::CAPTURE:
+            case Frame::ELEMENTS:
+                push(Frame::CAPTURE, top.path, YAML::Node(), false, is_map);
+                if (anchor != YAML::NullAnchor) anchors_[anchor] = frames_.back().node;
+                return;
+            case Frame::MAP:
+                break;
+        }
+
+        // value of a field of a map of the schema
+        if (not top.has_key) throw StreamFallback("complex key");
+        auto              path              = childPath(top);
+        const YAML::Node& node_schema       = top.node_schema;
+        const YAML::Node  node_schema_child = node_schema[top.key];
+
+        // not in the schema
+        if (not node_schema_child.IsDefined())
+        {
+            if (isKept(top, path))
+                push(Frame::CAPTURE, path, YAML::Node(), false, is_map);
+            else
+                push(Frame::SKIP, path, YAML::Node(), false, is_map);
+        }
+        // map of the schema
+        else if (not isSpecification(node_schema_child) and is_map)
+            push(Frame::MAP, path, node_schema_child, isKept(top, path) or isNeeded(path), true);
+        // array field without VALUE and OPTIONS --> elements validated one by one
+        else if (isSpecification(node_schema_child) and not is_map and isStreamable(node_schema_child))
+        {
+            auto type = node_schema_child[TYPE].as<std::string>();
+
+            std::stringstream                     log_resolve;
+            YAML::Node                            node_schema_type;
+            std::shared_ptr<const CompiledSchema> compiled_schema_type;
+            if (not resolveTypeSchema(
+                    type, folders_schema_, node_schema_type, compiled_schema_type, log_resolve, override_))
+                push(Frame::CAPTURE, path, YAML::Node(), false, false);  // errors written when validated
+            else
+            {
+                push(Frame::ELEMENTS, path, node_schema_child, isKept(top, path), false);
+                frames_.back().element_type         = getLowerElementType(type);
+                frames_.back().node_schema_type     = node_schema_type;
+                frames_.back().compiled_schema_type = compiled_schema_type;
+                isArrayType(type, frames_.back().size);
+            }
+        }
+        // field --> materialized
+        else
+            push(Frame::CAPTURE, path, YAML::Node(), false, is_map);
+
+        if (anchor != YAML::NullAnchor and frames_.back().kind == Frame::CAPTURE)
+            anchors_[anchor] = frames_.back().node;
+    }
+
+    bool isStreamable(const YAML::Node& node_schema) const
+    {
+        auto type = node_schema[TYPE].as<std::string>();
+        return isArrayType(type) and not isDerivedType(type) and not node_schema[VALUE] and
+               not node_schema[OPTIONS];
+    }
+
+    // end of a map or a sequence
+    void end()
+    {
+        Frame frame = frames_.back();
+        frames_.pop_back();
+
+        switch (frame.kind)
+        {
+            case Frame::MAP:
+                completeMap(frame);
+                break;
+            case Frame::ELEMENTS:
+                // If size defined in type (!=0), complain if different
+                if (frame.size != 0 and frame.count != frame.size)
+                {
+                    writeErrorToLog(log_,
+                                    frame.path,
+                                    YAML::Node(YAML::NodeType::Undefined),
+                                    " wrong size, should be " + std::to_string(frame.size));
+                    is_valid_ = false;
+                }
+                break;
+            case Frame::CAPTURE:
+            case Frame::SKIP:
+                break;
+        }
+
+        // root
+        if (frames_.empty())
+        {
+            node_.reset(frame.node);
+            done_ = true;
+            return;
+        }
+
+        // already validated (except materialized nodes), only stored if kept
+        if (frame.kind == Frame::CAPTURE)
+            completeChild(frame.node, false);
+        else
+            completeChild(frame.keep ? frame.node : YAML::Node(YAML::NodeType::Undefined), true);
+    }
+
+    // fields of the schema not found in the map
+    void completeMap(Frame& frame)
+    {
+        for (auto node_schema_child : frame.node_schema)
+        {
+            auto key = node_schema_child.first.as<std::string>();
+            if (frame.seen.count(key)) continue;
+
+            YAML::Node node_input_child = frame.node[key];
+            is_valid_                   = applySchemaRecursive(node_input_child,
+                                             frame.node,
+                                             node_schema_child.second,
+                                             folders_schema_,
+                                             log_,
+                                             (frame.path.empty() ? "" : frame.path + "/") + key,
+                                             override_,
+                                             nullptr,
+                                             &compiled_schema_) and
+                        is_valid_;
+        }
+    }
+
+    // scalar, null or alias
+    void complete(const YAML::Node& node, YAML::anchor_t anchor)
+    {
+        if (frames_.empty()) throw StreamFallback("root is not a map");
+        if (anchor != YAML::NullAnchor) anchors_[anchor] = node;
+        completeChild(node, false);
+    }
+
+    // a key or a value completed in the top frame
+    void completeChild(const YAML::Node& node, bool validated)
+    {
+        Frame& top = frames_.back();
+        switch (top.kind)
+        {
+            case Frame::SKIP:
+                return;
+            case Frame::CAPTURE:
+                if (not top.node.IsMap())
+                    top.node.push_back(node);
+                else if (not top.has_key)
+                {
+                    top.key_node.reset(node);
+                    top.has_key  = true;
+                }
+                else
+                {
+                    top.node[top.key_node] = resolveRelativePath(node);
+                    top.has_key            = false;
+                }
+                return;
+            case Frame::ELEMENTS: {
+                YAML::Node node_input_i = node;
+                is_valid_               = applySchemaResolved(node_input_i,
+                                                top.element_type,
+                                                top.node_schema_type,
+                                                folders_schema_,
+                                                log_,
+                                                top.path + "[" + std::to_string(top.count) + "]",
+                                                override_,
+                                                nullptr,
+                                                top.compiled_schema_type.get()) and
+                            is_valid_;
+                if (top.keep) top.node.push_back(node_input_i);
+                top.count++;
+                return;
+            }
+            case Frame::MAP:
+                break;
+        }
+
+        // key
+        if (not top.has_key)
+        {
+            if (not node.IsScalar()) throw StreamFallback("complex key");
+            top.key = node.Scalar();
+            if (top.key == "follow") throw StreamFallback("follow");
+            if (top.seen.count(top.key)) throw StreamFallback("repeated key " + top.key);
+            top.has_key = true;
+            return;
+        }
+
+        // value
+        top.has_key = false;
+        top.seen.insert(top.key);
+        auto              path              = childPath(top);
+        const YAML::Node& node_schema       = top.node_schema;
+        const YAML::Node  node_schema_child = node_schema[top.key];
+
+        YAML::Node node_input = validated ? node : resolveRelativePath(node);
+        if (not validated and node_schema_child.IsDefined())
+            is_valid_ = applySchemaRecursive(node_input,
+                                             top.node,
+                                             node_schema_child,
+                                             folders_schema_,
+                                             log_,
+                                             path,
+                                             override_,
+                                             nullptr,
+                                             &compiled_schema_) and
+                        is_valid_;
+
+        // store scalars (needed to evaluate expressions) and kept fields
+        if (node_input.IsDefined() and (validated or node_input.IsScalar() or isKept(top, path)))
+            top.node[top.key] = node_input;
+    }
+
+    const CompiledSchema&           compiled_schema_;
+    YAML::Node                      node_schema_;
+    std::string                     current_folder_;
+    std::vector<std::string>        folders_schema_;
+    std::stringstream&              log_;
+    std::vector<std::string>        keep_;
+    bool                            override_;
+    bool                            is_valid_;
+    bool                            done_;
+    std::vector<Frame>              frames_;
+    std::map<YAML::anchor_t, YAML::Node> anchors_;
+    YAML::Node                      node_;
+};
+
+// the fields in 'keep' of node
+YAML::Node keptFields(const YAML::Node& node, const std::vector<std::string>& keep)
+{
+    YAML::Node node_output(YAML::NodeType::Map);
+    for (auto& keep_path : keep)
+    {
+        // find
+        YAML::Node node_field = node;
+        std::vector<std::string> keys;
+        std::stringstream        keep_path_ss(keep_path);
+        std::string              key;
+        while (std::getline(keep_path_ss, key, '/'))
+        {
+            if (not node_field.IsMap()) break;
+            node_field.reset(static_cast<const YAML::Node&>(node_field)[key]);
+            keys.push_back(key);
+        }
+        if (keys.empty() or not node_field.IsDefined()) continue;
+
+        // add
+        YAML::Node node_output_field = node_output;
+        for (auto i = 0; i + 1 < keys.size(); i++)
+        {
+            YAML::Node next = node_output_field[keys[i]];
+            node_output_field.reset(next);
+        }
+        node_output_field[keys.back()] = node_field;
+    }
+    return node_output;
+}
+}  // namespace
+
+bool applySchemaStream(const std::string&              path_input,
+                       const std::string&              name_schema,
+                       const std::vector<std::string>& folders_schema,
+                       std::stringstream&              log,
+                       YAML::Node&                     node_output,
+                       const std::vector<std::string>& keep,
+                       bool                            override)
+{
+    // Check file exists
+    if (not filesystem::exists(path_input))
+    {
+        throw std::runtime_error("YAML file does not exists. Non-existing path: " + path_input);
+    }
+
+    std::ifstream input(path_input);
+    if (not input.is_open()) throw std::runtime_error("applySchemaStream: Failed to open the file: " + path_input);
+
+    return applySchemaStream(input,
+                             filesystem::path(path_input).parent_path().string(),
+                             name_schema,
+                             folders_schema,
+                             log,
+                             node_output,
+                             keep,
+                             override);
+}
+
+bool applySchemaStream(std::istream&                   input,
+                       const std::string&              current_folder,
+                       const std::string&              name_schema,
+                       const std::vector<std::string>& folders_schema,
+                       std::stringstream&              log,
+                       YAML::Node&                     node_output,
+                       const std::vector<std::string>& keep,
+                       bool                            override)
+{
+    auto compiled_schema = getCompiledSchema(name_schema, folders_schema, log, override);
+    if (not compiled_schema) return false;
+
+    // Validate while parsing
+    auto              start = input.tellg();
+    std::stringstream log_stream;
+    try
+    {
+        StreamValidator validator(*compiled_schema, current_folder, folders_schema, log_stream, keep, override);
+        YAML::Parser    parser(input);
+        if (parser.HandleNextDocument(validator) and validator.isDone())
+        {
+            log << log_stream.str();
+            node_output.reset(keptFields(validator.getNode(), keep));
+            return validator.isValid();
+        }
+    }
+    catch (const StreamFallback& e)
+    {
+    }
+
+    // Load the whole document
+    input.clear();
+    if (start == std::istream::pos_type(-1) or not input.seekg(start))
+        throw std::runtime_error("applySchemaStream: the document has to be loaded but the stream is not seekable");
+
+    YAML::Node node_input = YAML::Load(input);
+    flattenNode(node_input, current_folder, {}, false, override);
+
+    bool is_valid = applySchemaRecursive(node_input,
+                                         node_input,
+                                         compiled_schema->node,
+                                         folders_schema,
+                                         log,
+                                         "",
+                                         override,
+                                         nullptr,
+                                         compiled_schema.get());
+    node_output.reset(keptFields(node_input, keep));
+    return is_valid;
+}
+
+}  // namespace yaml_schema_cpp
@@ -1,7 +1,9 @@
 #include <stdexcept>
 #include <iostream>
+#include <thread>
 
 #include "yaml-schema-cpp/yaml_generator.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
 #include "yaml-schema-cpp/filesystem_wrapper.hpp"
 
 using std::cerr;
@@ -24,6 +26,14 @@ int main(int argc, char* argv[])
      *
      *   NOTE 1: Paths can be absolute (starting by '/') or relative.
      *   NOTE 2: 'output_file' will be modified to avoid overriding existing files.
+     *
+     * BATCH CALL:
+     *
+     *   yaml_template_generator --all schema_folders output_folder n_threads
+     *
+     *   Templates of all schemas found in 'schema_folders', written in 'output_folder' as
+     *   '<schema_name>_template.yaml' (existing files are overwritten).
+     *   'n_threads':      (OPTIONAL) Number of templates generated in parallel (default: number of cores).
      */
 
     // HELP
@@ -40,7 +50,43 @@ int main(int argc, char* argv[])
         cout << "                  If not provided, it will be placed in $HOME with a default" << endl;
         cout << "                  name based on schema_name (requires `$HOME` to be defined)." << endl << endl;
         cout << "NOTE 1: Paths can be absolute (starting by '/') or relative." << endl;
-        cout << "NOTE 2: 'output_file' will be modified to avoid overriding existing files." << endl;
+        cout << "NOTE 2: 'output_file' will be modified to avoid overriding existing files." << endl << endl;
+        cout << "Batch mode, templates of all schemas in 'schema_folders':" << endl;
+        cout << "yaml_template_generator --all schema_folders output_folder n_threads" << endl << endl;
+        cout << "'output_folder':  Templates written as '<schema_name>_template.yaml' (existing files overwritten)."
+             << endl;
+        cout << "'n_threads':      (OPTIONAL) Number of templates generated in parallel (default: number of cores)."
+             << endl;
+        return 0;
+    }
+    // Batch call
+    if ((argc == 4 or argc == 5) and std::string(argv[1]) == "--all")
+    {
+        filesystem::path current_path(filesystem::current_path());
+
+        std::vector<std::string> schema_folders;
+        unsigned int             n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        try
+        {
+            schema_folders = parseFoldersArgument(argv[2], current_path.string());
+            if (argc == 5) n_threads = std::stoul(argv[4]);
+        }
+        catch (const std::exception& e)
+        {
+            cout << red << "ERROR: " << e.what() << reset;
+            return 1;
+        }
+
+        std::string output_folder(argv[3]);
+        if (output_folder.front() != '/') output_folder = (current_path / output_folder).string();
+
+        std::stringstream log;
+        if (not generateTemplates(output_folder, schema_folders, log, true, n_threads))
+        {
+            cout << red << "ERROR: Failed to generate some YAML templates:\n" << log.str() << reset;
+            return 1;
+        }
+        cout << "Template YAML files created correctly in: " << output_folder << endl;
         return 0;
     }
     // Call
@@ -52,45 +98,15 @@ int main(int argc, char* argv[])
         std::string schema(argv[1]);
 
         // schema folders
-        std::string              schema_folders_input(argv[2]);
         std::vector<std::string> schema_folders;
-        if (schema_folders_input.front() == '[' and schema_folders_input.back() == ']')
+        try
         {
-            // remove '[' and ']'
-            schema_folders_input.erase(0, 1);
-            schema_folders_input.pop_back();
-
-            size_t pos = 0;
-            while (not schema_folders_input.empty())
-            {
-                pos = schema_folders_input.find(" ");
-                schema_folders.push_back(schema_folders_input.substr(0, pos));
-
-                // next folder
-                schema_folders_input.erase(0, pos);
-
-                // remove spaces
-                while (schema_folders_input.front() == ' ') schema_folders_input.erase(0, 1);
-            }
+            schema_folders = parseFoldersArgument(argv[2], current_path.string());
         }
-        else
-            schema_folders.push_back(schema_folders_input);
-
-        // Correct paths to absolute
-        for (auto i = 0; i < schema_folders.size(); i++)
+        catch (const std::exception& e)
         {
-            // HOME char '~'
-            if (schema_folders[i].front() == '~')
-                if (getenv("HOME") == NULL)
-                {
-                    cout << red << "ERROR: path contains '~' but environment variable HOME not defined." << reset;
-                    return 1;
-                }
-                else
-                    schema_folders[i] = std::string(getenv("HOME")) + schema_folders[i].substr(1);
-
-            // relative path
-            if (schema_folders[i].front() != '/') schema_folders[i] = current_path.string() + "/" + schema_folders[i];
+            cout << red << "ERROR: " << e.what() << reset;
+            return 1;
         }
 
         // default output_file
@@ -4,27 +4,351 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <future>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 #include "yaml-schema-cpp/type_check.hpp"
 #include "yaml-schema-cpp/filesystem_wrapper.hpp"
 #include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/expression.hpp"
+#include "yaml-schema-cpp/yaml_hash.hpp"
 
 namespace yaml_schema_cpp
 {
 
-void flattenNode(YAML::Node&              node,
-                 std::string              current_folder,
-                 std::vector<std::string> schema_folders,
-                 bool                     is_schema,
-                 bool                     override)
+namespace
+{
+// loaded and flattened file of a 'follow'
+struct FollowedFile
+{
+    YAML::Node  node;
+    bool        is_schema;
+    std::string parent_path;
+};
+
+// path resolutions, include graph and flattened files shared by all the recursive calls (and threads) of a flatten
+class FlattenSession
+{
+  public:
+    // findFileRecursive(), cached
+    std::string findSchemaFile(const std::string& name, const std::vector<std::string>& folders)
+    {
+        std::string key = name;
+        for (const auto& folder : folders) key += '\0' + folder;
+
+        return memoized<std::string>(schema_files_, key, [&]() { return findFileRecursive(name, folders); });
+    }
+
+    // filesystem::exists(), cached by the normalized path (same file reached from different folders)
+    bool exists(const std::string& path)
+    {
+        auto key = filesystem::path(path).lexically_normal().string();
+
+        return memoized<bool>(exists_, key, [&]() { return filesystem::exists(path); });
+    }
+
+    void addLoaded(const LoadedFile& loaded_file)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loaded_files_.push_back(loaded_file);
+    }
+
+    std::vector<LoadedFile> loadedFiles()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loaded_files_;
+    }
+
+    // add the edge 'path_file follows path_follow' to the include graph (throws if it closes a cycle)
+    void addFollow(const std::string& path_file, const std::string& path_follow)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // path_file reachable from path_follow --> cycle (breadth first, shortest one)
+        std::unordered_map<std::string, std::string> previous{{path_follow, ""}};
+        std::vector<std::string>                     queue{path_follow};
+        for (size_t i = 0; i < queue.size() and not previous.count(path_file); i++)
+        {
+            for (const auto& next : follows_[queue[i]])
+            {
+                if (previous.emplace(next, queue[i]).second) queue.push_back(next);
+            }
+        }
+        if (previous.count(path_file))
+        {
+            // path_file -> path_follow -> ... -> path_file
+            std::string cycle;
+            for (auto path = path_file; not path.empty(); path = previous[path])
+            {
+                cycle = " -> " + path + cycle;
+            }
+            throw std::runtime_error("In flattenNode: cyclic 'follow': " + path_file + cycle);
+        }
+
+        follows_[path_file].insert(path_follow);
+    }
+
+    // loaded and flattened file (see loadFollowed()), only the first time. Afterwards, copies of it.
+    FollowedFile resolve(const std::string& key, const std::function<FollowedFile()>& load)
+    {
+        std::shared_ptr<std::promise<FollowedFile>> promise;
+        std::shared_future<FollowedFile>            future;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto                        it = files_.find(key);
+            if (it == files_.end())
+            {
+                promise = std::make_shared<std::promise<FollowedFile>>();
+                it      = files_.emplace(key, promise->get_future().share()).first;
+            }
+            future = it->second;
+        }
+
+        // resolved (or being resolved in another thread)
+        if (not promise)
+        {
+            auto followed = future.get();
+            followed.node = Clone(followed.node);
+            return followed;
+        }
+
+        // resolve, keeping an untouched copy (the returned node is modified when merged)
+        try
+        {
+            auto followed = load();
+            promise->set_value(FollowedFile{Clone(followed.node), followed.is_schema, followed.parent_path});
+            return followed;
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+  private:
+    // value computed only the first time, outside the lock (other threads asking for the same key wait for it)
+    template <typename T>
+    T memoized(std::unordered_map<std::string, std::shared_future<T>>& values,
+               const std::string&                                      key,
+               const std::function<T()>&                               compute)
+    {
+        std::shared_ptr<std::promise<T>> promise;
+        std::shared_future<T>            future;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto                        it = values.find(key);
+            if (it == values.end())
+            {
+                promise = std::make_shared<std::promise<T>>();
+                it      = values.emplace(key, promise->get_future().share()).first;
+            }
+            future = it->second;
+        }
+
+        if (promise)
+        {
+            try
+            {
+                promise->set_value(compute());
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+        }
+        return future.get();
+    }
+
+    std::mutex                                                        mutex_;
+    std::unordered_map<std::string, std::shared_future<std::string>>  schema_files_;  // by name and folders
+    std::unordered_map<std::string, std::shared_future<bool>>         exists_;
+    std::unordered_map<std::string, std::set<std::string>>            follows_;  // include graph
+    std::unordered_map<std::string, std::shared_future<FollowedFile>> files_;    // flattened files
+    std::vector<LoadedFile>                                           loaded_files_;
+};
+
+void flattenNode(YAML::Node&                     node,
+                 const std::string&              current_folder,
+                 const std::vector<std::string>& schema_folders,
+                 bool                            is_schema,
+                 bool                            override,
+                 bool                            parallel,
+                 FlattenSession&                 session,
+                 const std::string&              path_file);
+
+void flattenMap(YAML::Node&                     node,
+                const std::string&              current_folder,
+                const std::vector<std::string>& schema_folders,
+                bool                            is_schema,
+                bool                            override,
+                bool                            parallel,
+                FlattenSession&                 session,
+                const std::string&              path_file);
+
+void flattenSequence(YAML::Node&                     node,
+                     const std::string&              current_folder,
+                     const std::vector<std::string>& schema_folders,
+                     bool                            is_schema,
+                     bool                            override,
+                     bool                            parallel,
+                     FlattenSession&                 session,
+                     const std::string&              path_file);
+
+void insertNodes(YAML::Node&                     node,
+                 const YAML::Node&               node_follow,
+                 const std::string&              current_folder,
+                 const std::vector<std::string>& schema_folders,
+                 bool                            override,
+                 bool                            parallel,
+                 FlattenSession&                 session,
+                 const std::string&              path_file);
+
+FollowedFile loadFollowed(std::string                     path_follow_str,
+                          const std::string&              current_folder,
+                          const std::vector<std::string>& schema_folders,
+                          bool                            override,
+                          bool                            parallel,
+                          FlattenSession&                 session,
+                          const std::string&              path_file)
+{
+    std::string path_follow;
+
+    // if no extension --> schema
+    if (filesystem::path(path_follow_str).extension().empty()) path_follow_str += SCHEMA_EXTENSION;
+
+    // is schema?
+    bool following_is_schema = filesystem::path(path_follow_str).extension() == SCHEMA_EXTENSION;
+
+    // following file is schema --> findFileRecursive
+    if (following_is_schema)
+    {
+        path_follow = session.findSchemaFile(path_follow_str, schema_folders);
+        if (path_follow.empty())
+        {
+            throw std::runtime_error("In flattenNode: file '" + path_follow_str + "' not found");
+        }
+    }
+    // following file is regular yaml --> relative path
+    else if (filesystem::path(path_follow_str).extension() == ".yaml")
+    {
+        path_follow = current_folder + "/" + path_follow_str;
+    }
+    // wrong extension
+    else
+    {
+        throw std::runtime_error("In flattenNode: follow '" + path_follow_str +
+                                 "' bad extension, should be '.yaml', '.schema' or empty (assumed '.schema')");
+    }
+    // file does not exist
+    if (not session.exists(path_follow))
+    {
+        throw std::runtime_error("In flattenNode: the file '" + path_follow + "' does not exists");
+    }
+
+    // include graph: each file is loaded and flattened once (its followed files first), cycles are errors
+    auto path_follow_normal = filesystem::path(path_follow).lexically_normal().string();
+    session.addFollow(path_file, path_follow_normal);
+
+    auto key = path_follow_normal;
+    if (following_is_schema)
+    {
+        key += '\0' + current_folder;
+        for (const auto& folder : schema_folders) key += '\0' + folder;
+    }
+    return session.resolve(key, [&]() {
+        // load "following" file
+        LoadedFile   loaded_file;
+        FollowedFile followed{loadFile(path_follow, loaded_file),
+                              following_is_schema,
+                              filesystem::path(path_follow).parent_path().string()};
+        session.addLoaded(loaded_file);
+
+        // Recursively flatten the "following" file
+        if (following_is_schema)
+        {
+            flattenNode(followed.node,
+                        current_folder,
+                        schema_folders,
+                        following_is_schema,
+                        override,
+                        parallel,
+                        session,
+                        path_follow_normal);
+        }
+        else
+        {
+            flattenNode(followed.node,
+                        followed.parent_path,
+                        {},
+                        following_is_schema,
+                        override,
+                        parallel,
+                        session,
+                        path_follow_normal);
+        }
+
+        return followed;
+    });
+}
+
+void mergeFollowed(YAML::Node& node, const FollowedFile& followed, bool override)
+{
+    // add all new children to original node
+    for (auto nc : followed.node)
+    {
+        // Case schema
+        if (followed.is_schema)
+        {
+            addNodeSchema(node, nc.first.as<std::string>(), nc.second, override, followed.parent_path);
+        }
+        // Case input yaml
+        else
+        {
+            addNodeYaml(node, nc.first.as<std::string>(), nc.second, override, followed.parent_path);
+        }
+    }
+}
+
+// all files of a 'follow' value (single or sequence, possibly nested), in order
+void collectFollowed(const YAML::Node& node_follow, std::vector<std::string>& paths_follow)
+{
+    if (node_follow.IsSequence())
+    {
+        for (auto node_follow_i : node_follow)
+        {
+            collectFollowed(node_follow_i, paths_follow);
+        }
+    }
+    else
+    {
+        paths_follow.push_back(node_follow.as<std::string>());
+    }
+}
+void flattenNode(YAML::Node&                     node,
+                 const std::string&              current_folder,
+                 const std::vector<std::string>& schema_folders,
+                 bool                            is_schema,
+                 bool                            override,
+                 bool                            parallel,
+                 FlattenSession&                 session,
+                 const std::string&              path_file)
 {
     switch (node.Type())
     {
         case YAML::NodeType::Map:
-            flattenMap(node, current_folder, schema_folders, is_schema, override);
+            flattenMap(node, current_folder, schema_folders, is_schema, override, parallel, session, path_file);
             break;
         case YAML::NodeType::Sequence:
-            flattenSequence(node, current_folder, schema_folders, is_schema, override);
+            flattenSequence(node, current_folder, schema_folders, is_schema, override, parallel, session, path_file);
             break;
         case YAML::NodeType::Scalar:
         default:
@@ -32,36 +356,83 @@ void flattenNode(YAML::Node&              node,
     }
 }
 
-void flattenSequence(YAML::Node&              node,
-                     std::string              current_folder,
-                     std::vector<std::string> schema_folders,
-                     bool                     is_schema,
-                     bool                     override)
+void flattenSequence(YAML::Node&                     node,
+                     const std::string&              current_folder,
+                     const std::vector<std::string>& schema_folders,
+                     bool                            is_schema,
+                     bool                            override,
+                     bool                            parallel,
+                     FlattenSession&                 session,
+                     const std::string&              path_file)
 {
     for (auto node_i : node)
     {
-        flattenNode(node_i, current_folder, schema_folders, is_schema, override);
+        flattenNode(node_i, current_folder, schema_folders, is_schema, override, parallel, session, path_file);
     }
 }
 
-void flattenMap(YAML::Node&              node,
-                std::string              current_folder,
-                std::vector<std::string> schema_folders,
-                bool                     is_schema,
-                bool                     override)
+void flattenMap(YAML::Node&                     node,
+                const std::string&              current_folder,
+                const std::vector<std::string>& schema_folders,
+                bool                            is_schema,
+                bool                            override,
+                bool                            parallel,
+                FlattenSession&                 session,
+                const std::string&              path_file)
 {
+    // Parallel: start loading all followed files (independent documents), merged below in their order.
+    // Errors are thrown when the future is consumed, so the first error is the same as sequentially.
+    std::vector<std::string> paths_follow;
+    if (parallel)
+    {
+        for (auto n : node)
+        {
+            if (n.first.Scalar() == "follow") collectFollowed(n.second, paths_follow);
+        }
+    }
+    std::vector<std::future<FollowedFile>> futures_follow;
+    if (paths_follow.size() > 1)
+    {
+        for (const auto& path_follow_str : paths_follow)
+        {
+            futures_follow.push_back(std::async(std::launch::async,
+                                                loadFollowed,
+                                                path_follow_str,
+                                                std::cref(current_folder),
+                                                std::cref(schema_folders),
+                                                override,
+                                                parallel,
+                                                std::ref(session),
+                                                std::cref(path_file)));
+        }
+    }
+    auto next_future = futures_follow.begin();
+
     YAML::Node node_aux;  // Done using copy to preserve order of follow
     for (auto n : node)
     {
         // If follow node --> insert following yamls
-        if (n.first.as<std::string>() == "follow")
+        if (n.first.Scalar() == "follow")
         {
-            insertNodes(node_aux, n.second, current_folder, schema_folders, override);
+            if (futures_follow.empty())
+            {
+                insertNodes(
+                    node_aux, n.second, current_folder, schema_folders, override, parallel, session, path_file);
+            }
+            else
+            {
+                std::vector<std::string> paths_follow_n;
+                collectFollowed(n.second, paths_follow_n);
+                for (size_t i = 0; i < paths_follow_n.size(); i++, next_future++)
+                {
+                    mergeFollowed(node_aux, next_future->get(), override);
+                }
+            }
         }
         // If not follow node --> flatten & add
         else
         {
-            flattenNode(n.second, current_folder, schema_folders, is_schema, override);
+            flattenNode(n.second, current_folder, schema_folders, is_schema, override, parallel, session, path_file);
 
             // Case schema
             if (is_schema)
@@ -79,95 +450,88 @@ void flattenMap(YAML::Node&              node,
     node = node_aux;
 }
 
-void insertNodes(YAML::Node&              node,
-                 const YAML::Node&        node_follow,
-                 std::string              current_folder,
-                 std::vector<std::string> schema_folders,
-                 bool                     override)
+void insertNodes(YAML::Node&                     node,
+                 const YAML::Node&               node_follow,
+                 const std::string&              current_folder,
+                 const std::vector<std::string>& schema_folders,
+                 bool                            override,
+                 bool                            parallel,
+                 FlattenSession&                 session,
+                 const std::string&              path_file)
 {
     // sequence of follows --> recursively call insertNodes
     if (node_follow.IsSequence())
     {
         for (auto node_follow_i : node_follow)
         {
-            insertNodes(node, node_follow_i, current_folder, schema_folders, override);
+            insertNodes(node, node_follow_i, current_folder, schema_folders, override, parallel, session, path_file);
         }
     }
     // insert nodes from loaded YAML file
     else
     {
-        std::string path_follow_str = node_follow.as<std::string>();
-        std::string path_follow;
-
-        // if no extension --> schema
-        if (filesystem::path(path_follow_str).extension().empty()) path_follow_str += SCHEMA_EXTENSION;
+        auto followed = loadFollowed(
+            node_follow.as<std::string>(), current_folder, schema_folders, override, parallel, session, path_file);
+        mergeFollowed(node, followed, override);
+    }
+}
+}  // namespace
 
-        // is schema?
-        bool following_is_schema = filesystem::path(path_follow_str).extension() == SCHEMA_EXTENSION;
+void flattenNode(YAML::Node&              node,
+                 std::string              current_folder,
+                 std::vector<std::string> schema_folders,
+                 bool                     is_schema,
+                 bool                     override,
+                 bool                     parallel)
+{
+    FlattenSession session;
+    flattenNode(node, current_folder, schema_folders, is_schema, override, parallel, session, "");
+}
 
-        // following file is schema --> findFileRecursive
-        if (following_is_schema)
-        {
-            path_follow = findFileRecursive(path_follow_str, schema_folders);
-            if (path_follow.empty())
-            {
-                throw std::runtime_error("In flattenNode: file '" + path_follow_str + "' not found");
-            }
-        }
-        // following file is regular yaml --> relative path
-        else if (filesystem::path(path_follow_str).extension() == ".yaml")
-        {
-            path_follow = current_folder + "/" + path_follow_str;
-        }
-        // wrong extension
-        else
-        {
-            throw std::runtime_error("In flattenNode: follow '" + path_follow_str +
-                                     "' bad extension, should be '.yaml', '.schema' or empty (assumed '.schema')");
-        }
-        // file does not exist
-        if (not filesystem::exists(path_follow))
-        {
-            throw std::runtime_error("In flattenNode: the file '" + path_follow + "' does not exists");
-        }
+void flattenNode(YAML::Node&              node,
+                 std::string              current_folder,
+                 std::vector<std::string> schema_folders,
+                 bool                     is_schema,
+                 bool                     override,
+                 bool                     parallel,
+                 std::vector<LoadedFile>& loaded_files)
+{
+    FlattenSession session;
+    flattenNode(node, current_folder, schema_folders, is_schema, override, parallel, session, "");
+    loaded_files = session.loadedFiles();
+}
 
-        // load "following" file
-        YAML::Node node_child = YAML::LoadFile(path_follow);
+void flattenMap(YAML::Node&              node,
+                std::string              current_folder,
+                std::vector<std::string> schema_folders,
+                bool                     is_schema,
+                bool                     override,
+                bool                     parallel)
+{
+    FlattenSession session;
+    flattenMap(node, current_folder, schema_folders, is_schema, override, parallel, session, "");
+}
 
-        // Recursively flatten the "following" file
-        if (following_is_schema)
-        {
-            flattenNode(node_child, current_folder, schema_folders, following_is_schema, override);
-        }
-        else
-        {
-            flattenNode(
-                node_child, filesystem::path(path_follow).parent_path().string(), {}, following_is_schema, override);
-        }
+void flattenSequence(YAML::Node&              node,
+                     std::string              current_folder,
+                     std::vector<std::string> schema_folders,
+                     bool                     is_schema,
+                     bool                     override,
+                     bool                     parallel)
+{
+    FlattenSession session;
+    flattenSequence(node, current_folder, schema_folders, is_schema, override, parallel, session, "");
+}
 
-        // add all new children to original node
-        for (auto nc : node_child)
-        {
-            // Case schema
-            if (following_is_schema)
-            {
-                addNodeSchema(node,
-                              nc.first.as<std::string>(),
-                              nc.second,
-                              override,
-                              filesystem::path(path_follow).parent_path().string());
-            }
-            // Case input yaml
-            else
-            {
-                addNodeYaml(node,
-                            nc.first.as<std::string>(),
-                            nc.second,
-                            override,
-                            filesystem::path(path_follow).parent_path().string());
-            }
-        }
-    }
+void insertNodes(YAML::Node&              node,
+                 const YAML::Node&        node_follow,
+                 std::string              current_folder,
+                 std::vector<std::string> schema_folders,
+                 bool                     override,
+                 bool                     parallel)
+{
+    FlattenSession session;
+    insertNodes(node, node_follow, current_folder, schema_folders, override, parallel, session, "");
 }
 
 void addNodeYaml(YAML::Node&        node,
@@ -220,16 +584,57 @@ void addNodeYaml(YAML::Node&        node,
     }
 
     // relative path input case
-    if (node[key].Type() == YAML::NodeType::Scalar)
+    if (node[key].IsScalar() and isRelativePathPrefix(node[key].Scalar()))
     {
-        std::string value_str = node[key].as<std::string>();
-        if ((value_str.size() > 1 and value_str.substr(0, 2) == "./") or
-            (value_str.size() > 2 and value_str.substr(0, 3) == "../"))
-        {
-            filesystem::path path_value = filesystem::path(parent_path) / filesystem::path(value.as<std::string>());
-            node[key]                   = path_value.string();
-        }
+        filesystem::path path_value = filesystem::path(parent_path) / filesystem::path(value.as<std::string>());
+        node[key]                   = path_value.string();
+    }
+}
+
+bool isRelativePathPrefix(const std::string& str)
+{
+    return str.compare(0, 2, "./") == 0 or str.compare(0, 3, "../") == 0;
+}
+
+long long lastWriteTime(const std::string& path)
+{
+#if _BOOST_FILESYSTEM_LIB == 1
+    boost::system::error_code ec;
+    auto                      time = filesystem::last_write_time(path, ec);
+    return ec ? -1 : (long long)time;
+#else
+    std::error_code ec;
+    auto            time = filesystem::last_write_time(path, ec);
+    return ec ? -1 : (long long)time.time_since_epoch().count();
+#endif
+}
+
+std::string hashContents(const std::string& contents)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (auto byte : contents)
+    {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 1099511628211ULL;
     }
+    std::stringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hex.str();
+}
+
+YAML::Node loadFile(const std::string& path, LoadedFile& loaded_file)
+{
+    // modification time before reading, so that a later change is always detected
+    loaded_file.path       = filesystem::path(path).lexically_normal().string();
+    loaded_file.write_time = lastWriteTime(path);
+
+    std::ifstream file(path, std::ios::binary);
+    if (not file.is_open()) throw YAML::BadFile(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    loaded_file.hash = hashContents(contents.str());
+    return YAML::Load(contents.str());
 }
 
 std::string findFileRecursive(const std::string& name_with_extension, const std::vector<std::string>& folders)
@@ -293,6 +698,49 @@ std::vector<std::string> getAllSchemas(const std::vector<std::string>& root_fold
     return schemas_found;
 }
 
+std::vector<std::string> parseFoldersArgument(std::string folders_argument, const std::string& current_path)
+{
+    std::vector<std::string> folders;
+    if (folders_argument.front() == '[' and folders_argument.back() == ']')
+    {
+        // remove '[' and ']'
+        folders_argument.erase(0, 1);
+        folders_argument.pop_back();
+
+        size_t pos = 0;
+        while (not folders_argument.empty())
+        {
+            pos = folders_argument.find(" ");
+            folders.push_back(folders_argument.substr(0, pos));
+
+            // next folder
+            folders_argument.erase(0, pos);
+
+            // remove spaces
+            while (not folders_argument.empty() and folders_argument.front() == ' ') folders_argument.erase(0, 1);
+        }
+    }
+    else
+        folders.push_back(folders_argument);
+
+    // Correct paths to absolute
+    for (auto i = 0; i < folders.size(); i++)
+    {
+        // HOME char '~'
+        if (folders[i].front() == '~')
+        {
+            if (getenv("HOME") == NULL)
+                throw std::runtime_error("path contains '~' but environment variable HOME not defined.");
+            folders[i] = std::string(getenv("HOME")) + folders[i].substr(1);
+        }
+
+        // relative path
+        if (folders[i].front() != '/') folders[i] = current_path + "/" + folders[i];
+    }
+
+    return folders;
+}
+
 void writeErrorToLog(std::stringstream& log,
                      const std::string& _acc_field,
                      const YAML::Node   _node_schema,
@@ -431,6 +879,13 @@ std::string getLowerElementType(const std::string type_str)
     return type_str.substr(0, pos_open) + type_str.substr(pos_close + 1, type_str.size() - pos_close - 1);
 }
 
+std::string getLowerElementType(const std::string& type_str, size_t depth)
+{
+    auto type = type_str;
+    for (size_t i = 0; i < depth; i++) type = getLowerElementType(type);
+    return type;
+}
+
 std::string getLowestElementType(const std::string type_str)
 {
     size_t pos_open  = type_str.find('[');
@@ -465,58 +920,23 @@ std::string getCheckType(const YAML::Node& node)
 
 bool compareNodesAutoType(const YAML::Node& node1, const YAML::Node& node2)
 {
-    // Different types
-    if (node1.IsDefined() != node2.IsDefined() or node1.IsNull() != node2.IsNull()) return false;
-    if (node1.IsScalar() != node2.IsScalar()) return false;
-    if (node1.IsSequence() != node2.IsSequence()) return false;
-    if (node1.IsMap() != node2.IsMap()) return false;
-
-    // Scalar --> compare
-    if (node1.IsScalar())
-    {
-        // try as int (1e3 == 1000 but strings are not the same)
-        if (tryNodeAs(node1, "int") and tryNodeAs(node2, "int")) return node1.as<int>() == node2.as<int>();
-        // try as double (1 == 1.000 but strings are not the same)
-        if (tryNodeAs(node1, "double") and tryNodeAs(node2, "double")) return node1.as<double>() == node2.as<double>();
-        // try as string
-        return node1.as<std::string>() == node2.as<std::string>();
-    }
-    // Sequence --> compare sizes & call compareNodesAutoType recursively
-    if (node1.IsSequence())
-    {
-        if (node1.size() != node2.size()) return false;
-
-        for (auto i = 0; i < node1.size(); i++)
-            if (not compareNodesAutoType(node1[i], node2[i])) return false;
-
-        // all equal
-        return true;
-    }
-    // Map --> compare keys & call compareNodesAutoType recursively
-    if (node1.IsMap())
-    {
-        if (node1.size() != node2.size()) return false;
-
-        for (auto node1_child : node1)
-        {
-            // key not found
-            if (not node2[node1_child.first.as<std::string>()]) return false;
-            // element not equal
-            if (not compareNodesAutoType(node1_child.second, node2[node1_child.first.as<std::string>()])) return false;
-        }
-        // all equal
-        return true;
-    }
-
-    // not map, sequence or scalar?
-    throw std::runtime_error("compareNodesAutoType: unknown node type!");
-    return false;
+    NodeHasher hasher;
+    return hasher.equal(node1, node2);
 }
 
 bool compare(const YAML::Node&               node1,
              const YAML::Node&               node2,
              const std::string&              type,
              const std::vector<std::string>& folders_schema)
+{
+    return compareResolved(node1, node2, type, YAML::Node(YAML::NodeType::Undefined), folders_schema);
+}
+
+bool compareResolved(const YAML::Node&               node1,
+                     const YAML::Node&               node2,
+                     const std::string&              type,
+                     const YAML::Node&               node_schema_type,
+                     const std::vector<std::string>& folders_schema)
 {
     if (not node1.IsDefined() or node1.IsNull() or not node2.IsDefined() or node2.IsNull()) return false;
 
@@ -524,7 +944,7 @@ bool compare(const YAML::Node&               node1,
     if (not checkSizes(node1, type)) return false;
     if (not checkSizes(node2, type)) return false;
 
-    // array type --> call recursively compare
+    // array type --> call recursively compareResolved
     if (isArrayType(type))
     {
         // same size
@@ -533,7 +953,8 @@ bool compare(const YAML::Node&               node1,
         // compare all elements
         for (auto i = 0; i < node1.size(); i++)
         {
-            if (not compare(node1[i], node2[i], getLowerElementType(type), folders_schema)) return false;
+            if (not compareResolved(node1[i], node2[i], getLowerElementType(type), node_schema_type, folders_schema))
+                return false;
         }
         return true;
     }
@@ -542,6 +963,8 @@ bool compare(const YAML::Node&               node1,
     {
         if (isTrivialType(type))
             return compareTrivial(node1, node2, type);
+        else if (node_schema_type.IsDefined())
+            return compareNonTrivialSchema(node1, node2, node_schema_type, folders_schema);
         else
             return compareNonTrivial(node1, node2, type, folders_schema);
     }
@@ -565,29 +988,29 @@ bool compareTrivial(const YAML::Node& node1, const YAML::Node& node2, const std:
         COMPARE_TYPE(string)
     }
 #if _EIGEN_FOUND == 1
-    COMPARE_TYPE(Eigen::VectorXd)
-    COMPARE_TYPE(Eigen::MatrixXd)
-
-    COMPARE_EIGEN(1)
-    COMPARE_EIGEN(2)
-    COMPARE_EIGEN(3)
-    COMPARE_EIGEN(4)
-    COMPARE_EIGEN(5)
-    COMPARE_EIGEN(6)
-    COMPARE_EIGEN(7)
-    COMPARE_EIGEN(8)
-    COMPARE_EIGEN(9)
-    COMPARE_EIGEN(10)
-    {
-        using namespace Eigen;
-        COMPARE_TYPE(VectorXd)
-        COMPARE_TYPE(VectorXd)
-    }
+    EigenType eigen_type;
+    if (parseEigenType(type, eigen_type)) return compareEigen(node1, node2, eigen_type);
 #endif
 
     throw std::runtime_error("compareTrivial() not implemented for type " + type);
 }
 
+#if _EIGEN_FOUND == 1
+bool compareEigen(const YAML::Node& node1, const YAML::Node& node2, const EigenType& eigen_type)
+{
+    switch (eigen_type.scalar)
+    {
+        case EigenType::DOUBLE:
+            return conversion::compareMatrix<double>(node1, node2, eigen_type.rows, eigen_type.cols, 1e-9);
+        case EigenType::FLOAT:
+            return conversion::compareMatrix<float>(node1, node2, eigen_type.rows, eigen_type.cols, 1e-9);
+        case EigenType::INT:
+            return conversion::compareMatrix<int>(node1, node2, eigen_type.rows, eigen_type.cols, 1e-9);
+    }
+    return false;
+}
+#endif
+
 bool compareNonTrivialSchema(const YAML::Node&               node1,
                              const YAML::Node&               node2,
                              const YAML::Node&               node_schema,
@@ -605,15 +1028,18 @@ bool compareNonTrivialSchema(const YAML::Node&               node1,
     }
     else
     {
+        // index children once instead of searching each schema key
+        auto node1_children = indexMapNode(node1);
+        auto node2_children = indexMapNode(node2);
         for (auto node_schema_child : node_schema)
         {
-
-            YAML::Node node1_child = node1[node_schema_child.first.as<std::string>()]
-                                         ? node1[node_schema_child.first.as<std::string>()]
-                                         : YAML::Node(YAML::NodeType::Undefined);
-            YAML::Node node2_child = node2[node_schema_child.first.as<std::string>()]
-                                         ? node2[node_schema_child.first.as<std::string>()]
-                                         : YAML::Node(YAML::NodeType::Undefined);
+            auto       key         = node_schema_child.first.as<std::string>();
+            auto       node1_found = node1_children.find(key);
+            auto       node2_found = node2_children.find(key);
+            YAML::Node node1_child =
+                node1_found != node1_children.end() ? node1_found->second : YAML::Node(YAML::NodeType::Undefined);
+            YAML::Node node2_child =
+                node2_found != node2_children.end() ? node2_found->second : YAML::Node(YAML::NodeType::Undefined);
 
             if (not compareNonTrivialSchema(node1_child, node2_child, node_schema_child.second, folders_schema))
                 return false;
@@ -649,6 +1075,127 @@ bool compareNonTrivial(const YAML::Node&               node1,
     return compareNonTrivialSchema(node1, node2, node_schema, folders_schema);
 }
 
+bool canonicalKey(const YAML::Node&               node,
+                  const std::string&              type,
+                  const YAML::Node&               node_schema_type,
+                  const std::vector<std::string>& folders_schema,
+                  std::string&                    key)
+{
+    if (not node.IsDefined() or node.IsNull()) return false;
+
+    // sequence if array type, and same size as array type (if specified)
+    if (not checkSizes(node, type)) return false;
+
+    // array type --> call recursively canonicalKey
+    if (isArrayType(type))
+    {
+        key += "[" + std::to_string(node.size()) + ":";
+        for (auto i = 0; i < node.size(); i++)
+        {
+            if (not canonicalKey(node[i], getLowerElementType(type), node_schema_type, folders_schema, key))
+                return false;
+        }
+        key += "]";
+        return true;
+    }
+    // scalar
+    else
+    {
+        if (isTrivialType(type)) return canonicalKeyTrivial(node, type, key);
+
+        // non trivial: resolve schema if not provided
+        YAML::Node node_schema = node_schema_type;
+        if (not node_schema.IsDefined())
+        {
+            std::stringstream log;
+            if (not resolveTypeSchema(type, folders_schema, node_schema, log)) return false;
+        }
+        return canonicalKeyNonTrivialSchema(node, node_schema, folders_schema, key);
+    }
+}
+
+bool canonicalKeyTrivial(const YAML::Node& node, const std::string& type, std::string& key)
+{
+    if (not node.IsDefined() or node.IsNull()) return false;
+
+    try
+    {
+        CANONICAL_KEY_INTEGER(int)
+        CANONICAL_KEY_INTEGER(unsigned int)
+        CANONICAL_KEY_INTEGER(long int)
+        CANONICAL_KEY_INTEGER(long unsigned int)
+        CANONICAL_KEY_REAL(float)
+        CANONICAL_KEY_REAL(double)
+        if (type == "bool")
+        {
+            key += node.as<bool>() ? "b1;" : "b0;";
+            return true;
+        }
+        if (type == "char")
+        {
+            key += "c" + std::string(1, node.as<char>()) + ";";
+            return true;
+        }
+        if (type == "string" or type == "std::string")
+        {
+            auto value = node.as<std::string>();
+            key += "s" + std::to_string(value.size()) + ":" + value;
+            return true;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        return false;
+    }
+
+    // Eigen types are compared with tolerance --> no exact key
+    return false;
+}
+
+bool canonicalKeyNonTrivialSchema(const YAML::Node&               node,
+                                  const YAML::Node&               node_schema,
+                                  const std::vector<std::string>& folders_schema,
+                                  std::string&                    key)
+{
+    if (isSpecification(node_schema))
+    {
+        // mandatory expressions not supported by compareNonTrivialSchema()
+        if (isExpression(node_schema[MANDATORY])) return false;
+
+        // not defined: equal to other not defined only if optional
+        if (not node.IsDefined())
+        {
+            if (node_schema[MANDATORY].as<bool>()) return false;
+            key += "~;";
+            return true;
+        }
+
+        // derived types cannot be compared
+        auto type = node_schema[TYPE].as<std::string>();
+        if (isDerivedType(type)) return false;
+
+        return canonicalKey(node, type, YAML::Node(YAML::NodeType::Undefined), folders_schema, key);
+    }
+    else
+    {
+        auto node_children = indexMapNode(node);
+        key += "{";
+        for (auto node_schema_child : node_schema)
+        {
+            auto       field      = node_schema_child.first.as<std::string>();
+            auto       node_found = node_children.find(field);
+            YAML::Node node_child =
+                node_found != node_children.end() ? node_found->second : YAML::Node(YAML::NodeType::Undefined);
+
+            key += std::to_string(field.size()) + ":" + field + "=";
+            if (not canonicalKeyNonTrivialSchema(node_child, node_schema_child.second, folders_schema, key))
+                return false;
+        }
+        key += "}";
+    }
+    return true;
+}
+
 std::string getZeroString(const std::string& type)
 {
     size_t size;
@@ -675,28 +1222,21 @@ std::string getZeroString(const std::string& type)
         if (type == "char") return "A";
         if (type == "string" or type == "std::string") return "whatever";
 #if _EIGEN_FOUND == 1
-        if (type == "VectorXd" or type == "Eigen::VectorXd") return "[0.0, 0.0, 0.0]";
-        if (type == "MatrixXd" or type == "Eigen::MatrixXd") return "[[3, 2], [0.0, 0.0, 0.0, 0.0, 0.0, 0.0]]";
-
-        for (auto i = 1; i <= 10; i++)
+        EigenType eigen_type;
+        if (parseEigenType(type, eigen_type))
         {
-            if (type == "Vector" + std::to_string(i) + "d" or type == "Eigen::Vector" + std::to_string(i) + "d")
-            {
-                std::string string_ret = "[0.0";
-                for (auto j = 2; j <= i; j++) string_ret += ", 0.0";
-                string_ret += "]";
+            std::string zero         = eigen_type.scalar == EigenType::INT ? "0" : "0.0";
+            bool        full_dynamic = eigen_type.rows == Eigen::Dynamic and eigen_type.cols == Eigen::Dynamic;
 
-                return string_ret;
-            }
+            // arbitrary sizes for dynamic dimensions: 3x2 if full dynamic (sizes required), 3 otherwise
+            int rows = full_dynamic ? 3 : (eigen_type.rows == Eigen::Dynamic ? 3 : eigen_type.rows);
+            int cols = full_dynamic ? 2 : (eigen_type.cols == Eigen::Dynamic ? 3 : eigen_type.cols);
 
-            if (type == "Matrix" + std::to_string(i) + "d" or type == "Eigen::Matrix" + std::to_string(i) + "d")
-            {
-                std::string string_ret = "[0.0";
-                for (auto j = 2; j <= i * i; j++) string_ret += ", 0.0";
-                string_ret += "]";
+            std::string string_ret = full_dynamic ? "[[3, 2], [" : "[";
+            for (auto i = 0; i < rows * cols; i++) string_ret += (i == 0 ? "" : ", ") + zero;
+            string_ret += full_dynamic ? "]]" : "]";
 
-                return string_ret;
-            }
+            return string_ret;
         }
 #endif
     }
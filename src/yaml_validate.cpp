@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "yaml-schema-cpp/validation_session.hpp"
+#include "yaml-schema-cpp/yaml_generator.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+
+using std::cout;
+using std::endl;
+using namespace yaml_schema_cpp;
+
+namespace
+{
+void printHelp()
+{
+    cout << "--------- yaml_validate HELP ---------- \nCall it with:" << endl;
+    cout << "yaml_validate [--fail-fast] [--json] [--threads n_threads] schema_name schema_folders input_files..."
+         << endl
+         << endl;
+    cout << "'schema_name':    Schema to be applied (just its name, without path or extension)" << endl;
+    cout << "'schema_folders': Path to the folder(s) that contains all the schema files (they are searched "
+            "recursively)."
+         << endl;
+    cout << "                  Provide more than one folder with '[path1 path2 ...]'" << endl;
+    cout << "'input_files':    Input files or patterns with '*', '?' and '**' (any folder, recursively)." << endl;
+    cout << "--fail-fast:      Stop validating files after the first one not valid (the rest are skipped)." << endl;
+    cout << "--json:           Output one JSON object per file (JSON lines) and a final summary (errors and warnings"
+         << endl
+         << "                  are also JSON objects: {\"error\": ...} or {\"warning\": ...})." << endl;
+    cout << "--threads:        Number of files validated in parallel (default: number of cores)." << endl << endl;
+    cout << "Exit code 0 if all files are valid, 1 otherwise." << endl;
+}
+
+bool hasWildcard(const std::string& str)
+{
+    return str.find_first_of("*?") != std::string::npos;
+}
+
+// '*' any sequence of characters, '?' any character
+bool matchWildcard(const std::string& pattern, const std::string& name)
+{
+    size_t p = 0, n = 0, star_p = std::string::npos, star_n = 0;
+    while (n < name.size())
+    {
+        if (p < pattern.size() and (pattern[p] == '?' or pattern[p] == name[n]))
+        {
+            p++;
+            n++;
+        }
+        else if (p < pattern.size() and pattern[p] == '*')
+        {
+            star_p = p++;
+            star_n = n;
+        }
+        else if (star_p != std::string::npos)
+        {
+            p = star_p + 1;
+            n = ++star_n;
+        }
+        else
+            return false;
+    }
+    while (p < pattern.size() and pattern[p] == '*') p++;
+    return p == pattern.size();
+}
+
+void expandGlob(const std::string&              base,
+                const std::vector<std::string>& components,
+                size_t                          index,
+                std::vector<std::string>&       paths)
+{
+    if (index == components.size())
+    {
+        if (filesystem::is_regular_file(base)) paths.push_back(base);
+        return;
+    }
+
+    auto folder = base.empty() ? std::string(".") : base;
+    auto child  = [&](const std::string& name) {
+        return base.empty() ? name : (base == "/" ? base : base + "/") + name;
+    };
+
+    const auto& component = components[index];
+    if (not hasWildcard(component))
+    {
+        expandGlob(child(component), components, index + 1, paths);
+        return;
+    }
+    if (not filesystem::is_directory(folder)) return;
+
+    std::vector<std::string> names;
+    for (auto const& entry : filesystem::directory_iterator(folder)) names.push_back(entry.path().filename().string());
+    std::sort(names.begin(), names.end());
+
+    // '**': zero or more folders
+    if (component == "**")
+    {
+        expandGlob(base, components, index + 1, paths);
+        for (auto name : names)
+            if (filesystem::is_directory(child(name))) expandGlob(child(name), components, index, paths);
+        return;
+    }
+    for (auto name : names)
+        if (matchWildcard(component, name)) expandGlob(child(name), components, index + 1, paths);
+}
+
+// input files of the argument (not modified if it has no wildcards)
+std::vector<std::string> expandInputArgument(const std::string& argument)
+{
+    if (not hasWildcard(argument)) return {argument};
+
+    std::vector<std::string> components;
+    std::stringstream        argument_ss(argument);
+    std::string              component;
+    while (std::getline(argument_ss, component, '/'))
+        if (not component.empty()) components.push_back(component);
+
+    std::vector<std::string> paths;
+    expandGlob(argument.front() == '/' ? "/" : "", components, 0, paths);
+    return paths;
+}
+
+std::string jsonString(const std::string& str)
+{
+    std::stringstream json;
+    json << '"';
+    for (auto c : str)
+    {
+        switch (c)
+        {
+            case '"':
+                json << "\\\"";
+                break;
+            case '\\':
+                json << "\\\\";
+                break;
+            case '\n':
+                json << "\\n";
+                break;
+            case '\t':
+                json << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    json << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+                else
+                    json << c;
+        }
+    }
+    json << '"';
+    return json.str();
+}
+
+// in JSON mode, a JSON object (so that the output is still JSON lines), otherwise colored text
+void printError(const std::string& message, bool json)
+{
+    if (json)
+        cout << "{\"error\": " << jsonString(message) << "}" << endl;
+    else
+        cout << red << "ERROR: " << message << reset << endl;
+}
+
+void printWarning(const std::string& message, bool json)
+{
+    if (json)
+        cout << "{\"warning\": " << jsonString(message) << "}" << endl;
+    else
+        cout << yellow << "WARNING: " << message << reset << endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    /* CALL:
+     *
+     *   yaml_validate [--fail-fast] [--json] [--threads n_threads] schema_name schema_folders input_files...
+     *
+     *   'schema_name':    Schema to be applied (just its name, without path or extension)
+     *   'schema_folders': Path to the folder(s) that contains all the schema files (they are searched recursively).
+     *                     Provide more than one folder with '[path1 path2 ...]'
+     *   'input_files':    Input files or patterns with '*', '?' and '**' (any folder, recursively).
+     *
+     *   The files are validated in parallel sharing the schema cache (see ValidationSession).
+     *   Exit code 0 if all files are valid, 1 otherwise.
+     */
+
+    // options (--json first, so that the errors of the other options are also reported as JSON)
+    bool         fail_fast = false;
+    bool         json      = std::find(argv + 1, argv + argc, std::string("--json")) != argv + argc;
+    unsigned int n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    int          arg       = 1;
+    try
+    {
+        for (; arg < argc and std::string(argv[arg]).compare(0, 2, "--") == 0; arg++)
+        {
+            std::string option(argv[arg]);
+            if (option == "--fail-fast")
+                fail_fast = true;
+            else if (option == "--json")
+                continue;
+            else if (option == "--threads" and arg + 1 < argc)
+                n_threads = std::stoul(argv[++arg]);
+            else if (json and option != "--help")
+            {
+                printError("Unknown option '" + option + "', see --help", json);
+                return 1;
+            }
+            else
+            {
+                printHelp();
+                return option == "--help" ? 0 : 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printError("Wrong number of threads '" + std::string(argv[arg]) + "': " + e.what(), json);
+        return 1;
+    }
+    if (argc - arg < 3)
+    {
+        if (json)
+            printError("Missing arguments, see --help", json);
+        else
+            printHelp();
+        return 1;
+    }
+
+    // schema and inputs
+    std::string              schema(argv[arg]);
+    std::vector<std::string> schema_folders;
+    try
+    {
+        schema_folders = parseFoldersArgument(argv[arg + 1], filesystem::current_path().string());
+    }
+    catch (const std::exception& e)
+    {
+        printError(e.what(), json);
+        return 1;
+    }
+    std::vector<std::string> paths_input;
+    for (auto i = arg + 2; i < argc; i++)
+    {
+        auto paths_argument = expandInputArgument(argv[i]);
+        if (paths_argument.empty()) printWarning("No files match '" + std::string(argv[i]) + "'", json);
+        paths_input.insert(paths_input.end(), paths_argument.begin(), paths_argument.end());
+    }
+
+    // validate
+    ValidationSession session(schema_folders, true, n_threads);
+    auto              results = session.applySchemaBatch(paths_input, schema, fail_fast);
+
+    // report
+    int n_valid = 0, n_skipped = 0;
+    for (auto result : results)
+    {
+        if (result.is_valid) n_valid++;
+        if (result.is_skipped) n_skipped++;
+
+        if (json)
+        {
+            cout << "{\"file\": " << jsonString(result.path_input)
+                 << ", \"valid\": " << (result.is_valid ? "true" : "false")
+                 << ", \"skipped\": " << (result.is_skipped ? "true" : "false") << ", \"time_ms\": " << std::fixed
+                 << std::setprecision(3) << result.time * 1e3;
+            if (not result.is_valid and not result.is_skipped) cout << ", \"log\": " << jsonString(result.log);
+            cout << "}" << endl;
+        }
+        else if (result.is_skipped)
+            cout << yellow << "SKIPPED " << result.path_input << reset << endl;
+        else if (result.is_valid)
+            cout << "OK      " << result.path_input << " (" << std::fixed << std::setprecision(1) << result.time * 1e3
+                 << " ms)" << endl;
+        else
+            cout << red << "ERROR   " << result.path_input << " (" << std::fixed << std::setprecision(1)
+                 << result.time * 1e3 << " ms)" << reset << endl
+                 << result.log << endl;
+    }
+
+    int n_invalid = results.size() - n_valid - n_skipped;
+    if (json)
+        cout << "{\"summary\": {\"files\": " << results.size() << ", \"valid\": " << n_valid
+             << ", \"invalid\": " << n_invalid << ", \"skipped\": " << n_skipped << "}}" << endl;
+    else
+        cout << results.size() << " files: " << n_valid << " valid, " << n_invalid << " not valid, " << n_skipped
+             << " skipped" << endl;
+
+    return n_valid == results.size() and not results.empty() ? 0 : 1;
+}
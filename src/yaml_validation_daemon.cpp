@@ -0,0 +1,70 @@
+#include <csignal>
+#include <iostream>
+
+#include "yaml-schema-cpp/yaml_daemon.hpp"
+#include "yaml-schema-cpp/yaml_generator.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+
+using std::cout;
+using std::endl;
+using namespace yaml_schema_cpp;
+
+namespace
+{
+YamlDaemon* running_daemon = nullptr;
+
+void stopDaemon(int)
+{
+    if (running_daemon) running_daemon->stop();
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    /* CALL:
+     *
+     *   yaml_validation_daemon schema_folders socket_path
+     *
+     *   'schema_folders': Path to the folder(s) that contains all the schema files (they are searched recursively).
+     *                     Provide more than one folder with '[path1 path2 ...]'
+     *   'socket_path':    Path of the Unix domain socket (a stale socket is replaced).
+     *
+     *   Serves validate, generate and diff requests (see YamlDaemon and yaml_daemon_client) until a stop request,
+     *   SIGINT or SIGTERM.
+     */
+
+    // HELP
+    if (argc != 3 or std::string(argv[1]) == "-h" or std::string(argv[1]) == "--help")
+    {
+        cout << "--------- yaml_validation_daemon HELP ---------- \nCall it with:" << endl;
+        cout << "yaml_validation_daemon schema_folders socket_path" << endl << endl;
+        cout << "'schema_folders': Path to the folder(s) that contains all the schema files (they are searched "
+                "recursively)."
+             << endl;
+        cout << "                  Provide more than one folder with '[path1 path2 ...]'" << endl;
+        cout << "'socket_path':    Path of the Unix domain socket (a stale socket is replaced)." << endl << endl;
+        cout << "Serves requests of yaml_daemon_client until a stop request, SIGINT or SIGTERM." << endl;
+        return argc == 2 ? 0 : 1;
+    }
+
+    try
+    {
+        auto schema_folders = parseFoldersArgument(argv[1], filesystem::current_path().string());
+
+        YamlDaemon daemon(schema_folders, argv[2]);
+        running_daemon = &daemon;
+        std::signal(SIGINT, stopDaemon);
+        std::signal(SIGTERM, stopDaemon);
+
+        cout << "yaml_validation_daemon listening in: " << argv[2] << endl;
+        daemon.run();
+        running_daemon = nullptr;
+    }
+    catch (const std::exception& e)
+    {
+        cout << red << "ERROR: " << e.what() << reset << endl;
+        return 1;
+    }
+    return 0;
+}
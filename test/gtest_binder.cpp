@@ -0,0 +1,93 @@
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/yaml_server.hpp"
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+struct BaseInput
+{
+    int                              param1;
+    std::string                      param2;
+    double                           param3;
+    std::string                      param4;
+    std::vector<int>                 param5;
+    double                           param6;
+    std::vector<double>              param7;
+    std::vector<std::vector<double>> param8;
+    void setParam4(const std::string& value)
+    {
+        param4 = value;
+    }
+};
+
+TEST(binder, bind)
+{
+    YamlServer server({ROOT_DIR}, ROOT_DIR + "/test/yaml/base_input.yaml");
+
+    BaseInput    input;
+    SchemaBinder binder;
+    binder.bind("map1/param1", input.param1)
+        .bind("map1/param2", input.param2)
+        .bind("map1/param3", input.param3)  // default
+        .bindSetter<std::string>("param4", [&input](const std::string& value) { input.setParam4(value); })
+        .bind("param5", input.param5)
+        .bind("param6", input.param6)
+        .bind("param7", input.param7)
+        .bind("param8", input.param8);
+    ASSERT_EQ(binder.size(), 8);
+    ASSERT_TRUE(binder.isBound("param8"));
+    ASSERT_FALSE(binder.isBound("map1"));
+
+    ASSERT_TRUE(server.applySchema("base_input", binder));
+
+    ASSERT_EQ(input.param1, 1);
+    ASSERT_EQ(input.param2, "string");
+    ASSERT_DOUBLE_EQ(input.param3, 3.5);
+    ASSERT_EQ(input.param4, "hello");
+    ASSERT_EQ(input.param5, std::vector<int>({5, 6, -1, -7, 0}));
+    ASSERT_DOUBLE_EQ(input.param6, 3.14);
+    ASSERT_EQ(input.param7, std::vector<double>({0, 2, 3}));
+    ASSERT_EQ(input.param8.size(), 3);
+    ASSERT_DOUBLE_EQ(input.param8[2][1], 5.9);
+}
+
+TEST(binder, bind_own_type_sequence)
+{
+    YamlServer server({ROOT_DIR}, ROOT_DIR + "/test/yaml/own_type/sequence_mandatory.yaml");
+
+    double       param3_0, param3_1;
+    bool         map1_assigned = false;
+    SchemaBinder binder;
+    binder.bind("own_type[0]/map1/param3", param3_0)
+        .bind("own_type[1]/map1/param3", param3_1)
+        .bindNode("own_type[1]/map1", [&map1_assigned](const YAML::Node& node) {
+            map1_assigned = true;
+            return true;
+        });
+
+    ASSERT_TRUE(server.applySchema("sequence_mandatory.schema", binder));
+
+    ASSERT_DOUBLE_EQ(param3_0, 3.5);  // default
+    ASSERT_DOUBLE_EQ(param3_1, 4.4);
+    ASSERT_FALSE(map1_assigned);  // not a specification, not assigned
+}
+
+TEST(binder, bind_wrong)
+{
+    YamlServer server({ROOT_DIR}, ROOT_DIR + "/test/yaml/base_input.yaml");
+
+    int          param2;
+    SchemaBinder binder;
+    binder.bind("map1/param2", param2);
+
+    ASSERT_FALSE(server.applySchema("base_input", binder));
+    ASSERT_NE(server.getLog().find("Could not assign value to bound variable"), std::string::npos);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
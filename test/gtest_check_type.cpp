@@ -1,6 +1,7 @@
 #include "gtest/utils_gtest.h"
 #include "yaml-schema-cpp/internal/config.h"
 #include "yaml-schema-cpp/type_check.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
 
 std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
 
@@ -295,6 +296,73 @@ TEST(check_type, Eigen_matrix)
     EXPECT_TRUE(tryNodeAs(node, "MatrixXd"));
     EXPECT_TRUE(tryNodeAs(node, "Eigen::MatrixXd"));
 }
+
+TEST(check_type, Eigen_grammar)
+{
+    EigenType eigen_type;
+
+    ASSERT_TRUE(parseEigenType("Vector16d", eigen_type));
+    EXPECT_EQ(eigen_type.scalar, EigenType::DOUBLE);
+    EXPECT_EQ(eigen_type.rows, 16);
+    EXPECT_EQ(eigen_type.cols, 1);
+
+    ASSERT_TRUE(parseEigenType("Eigen::Matrix<float, 12, 12>", eigen_type));
+    EXPECT_EQ(eigen_type.scalar, EigenType::FLOAT);
+    EXPECT_EQ(eigen_type.rows, 12);
+    EXPECT_EQ(eigen_type.cols, 12);
+
+    ASSERT_TRUE(parseEigenType("Matrix<int,Eigen::Dynamic,3>", eigen_type));
+    EXPECT_EQ(eigen_type.scalar, EigenType::INT);
+    EXPECT_EQ(eigen_type.rows, Eigen::Dynamic);
+    EXPECT_EQ(eigen_type.cols, 3);
+
+    ASSERT_TRUE(parseEigenType("Matrix2Xf", eigen_type));
+    EXPECT_EQ(eigen_type.rows, 2);
+    EXPECT_EQ(eigen_type.cols, Eigen::Dynamic);
+
+    ASSERT_TRUE(parseEigenType("RowVector6i", eigen_type));
+    EXPECT_EQ(eigen_type.rows, 1);
+    EXPECT_EQ(eigen_type.cols, 6);
+
+    for (auto type : {"Vector",
+                      "Vectord",
+                      "Vector3",
+                      "Vector3x",
+                      "Vector0d",
+                      "Vector3Xd",
+                      "Matrix<double, 3>",
+                      "Matrix<d, 3, 3>",
+                      "Matrix<double, 3, 3",
+                      "Matrix<long, 3, 3>",
+                      "Quaterniond",
+                      "Eigen::"})
+        EXPECT_FALSE(parseEigenType(type, eigen_type)) << type;
+
+    // check and compare
+    EXPECT_FALSE(tryNodeAs(YAML::Load("[1, 2, 3]"), "Matrix3i"));
+    EXPECT_TRUE(tryNodeAs(YAML::Load("[1, 2, 3, 4, 5, 6, 7, 8, 9]"), "Matrix3i"));
+    EXPECT_FALSE(tryNodeAs(YAML::Load("[1, 2, 3, 4, 5, 6, 7, 8, 9.5]"), "Matrix3i"));
+    EXPECT_TRUE(tryNodeAs(YAML::Load("[1, 2, 3, 4, 5, 6.5]"), "Vector6f"));
+    EXPECT_TRUE(tryNodeAs(YAML::Load("[1, 2, 3, 4, 5, 6]"), "Matrix<double, Dynamic, 3>"));
+    EXPECT_TRUE(compare(YAML::Load("[1, 2, 3]"), YAML::Load("[[3, 1], [1, 2, 3]]"), "Vector3i", {}));
+    EXPECT_FALSE(compare(YAML::Load("[1, 2, 3]"), YAML::Load("[1, 2, 4]"), "Vector3f", {}));
+
+    // zero strings are valid
+    for (auto type : {"Vector16d",
+                      "Vector6f",
+                      "Matrix3i",
+                      "Matrix<float, 12, 12>",
+                      "VectorXi",
+                      "MatrixXf",
+                      "Matrix2Xd",
+                      "Matrix<double, Dynamic, 3>",
+                      "RowVectorXd"})
+    {
+        EXPECT_TRUE(isTrivialType(type)) << type;
+        EXPECT_TRUE(isEigenType(type)) << type;
+        EXPECT_TRUE(tryNodeAs(YAML::Load(getZeroString(type)), type)) << type << ": " << getZeroString(type);
+    }
+}
 #endif
 
 TEST(check_type, trivial_types)
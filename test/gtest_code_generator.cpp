@@ -0,0 +1,161 @@
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/code_generator.hpp"
+#include "yaml-schema-cpp/yaml_server.hpp"
+
+// generated at build time by yaml_code_generator
+#include "single_mandatory.hpp"
+#include "expression.hpp"
+#if _EIGEN_FOUND == 1
+#include "StateP3d.hpp"
+#endif
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+TEST(code_generator, load_values_and_defaults)
+{
+    auto node = YAML::LoadFile(ROOT_DIR + "/test/yaml/own_type/single_mandatory.yaml");
+
+    auto output = single_mandatory::validateAndLoad(node);
+
+    ASSERT_EQ(output.own_type.map1.param1, 1);
+    ASSERT_EQ(output.own_type.map1.param2, "string");
+    ASSERT_DOUBLE_EQ(output.own_type.map1.param3, 3.5);  // default
+    ASSERT_EQ(output.own_type.param4, "hello");          // default
+    ASSERT_EQ(output.own_type.param5, std::vector<int>({5, 6, -1, -7, 0}));
+    ASSERT_DOUBLE_EQ(output.own_type.param6, 3.14);  // value
+    ASSERT_EQ(output.own_type.param7, std::vector<double>({0, 2, 3}));
+    ASSERT_TRUE(output.own_type.param8.empty());
+}
+
+TEST(code_generator, same_result_as_applySchema)
+{
+    YamlServer server({ROOT_DIR + "/test/schema"}, ROOT_DIR + "/test/yaml/own_type/single_mandatory.yaml");
+    ASSERT_TRUE(server.applySchema("single_mandatory"));
+
+    auto node   = server.getNode();
+    auto output = single_mandatory::validateAndLoad(node);
+
+    ASSERT_EQ(output.own_type.map1.param1, node["own_type"]["map1"]["param1"].as<int>());
+    ASSERT_EQ(output.own_type.map1.param2, node["own_type"]["map1"]["param2"].as<std::string>());
+    ASSERT_DOUBLE_EQ(output.own_type.map1.param3, node["own_type"]["map1"]["param3"].as<double>());
+    ASSERT_EQ(output.own_type.param4, node["own_type"]["param4"].as<std::string>());
+    ASSERT_EQ(output.own_type.param7, node["own_type"]["param7"].as<std::vector<double>>());
+}
+
+TEST(code_generator, errors)
+{
+    auto node = YAML::LoadFile(ROOT_DIR + "/test/yaml/own_type/single_mandatory.yaml");
+
+    single_mandatory::SingleMandatory output;
+    std::string                       error;
+
+    // missing mandatory
+    YAML::Node node_missing = YAML::Clone(node);
+    node_missing["own_type"]["map1"].remove("param1");
+    ASSERT_FALSE(single_mandatory::validateAndLoad(node_missing, output, error));
+    ASSERT_EQ(error, "ERROR in 'own_type/map1/param1': Missing mandatory field.");
+
+    // missing map with mandatory fields
+    YAML::Node node_missing_map = YAML::Clone(node);
+    node_missing_map["own_type"].remove("map1");
+    ASSERT_FALSE(single_mandatory::validateAndLoad(node_missing_map, output, error));
+    ASSERT_EQ(error, "ERROR in 'own_type/map1/param1': Missing mandatory field.");
+
+    // wrong type
+    YAML::Node node_type = YAML::Clone(node);
+    node_type["own_type"]["map1"]["param1"] = "one";
+    ASSERT_FALSE(single_mandatory::validateAndLoad(node_type, output, error));
+    ASSERT_EQ(error, "ERROR in 'own_type/map1/param1': Wrong type");
+
+    // not in options
+    YAML::Node node_options = YAML::Clone(node);
+    node_options["own_type"]["map1"]["param2"] = "strung";
+    ASSERT_FALSE(single_mandatory::validateAndLoad(node_options, output, error));
+    ASSERT_EQ(error, "ERROR in 'own_type/map1/param2': Wrong value. Allowed values defined in OPTIONS.");
+
+    // different from value
+    YAML::Node node_value = YAML::Clone(node);
+    node_value["own_type"]["param6"] = 1.56;
+    ASSERT_FALSE(single_mandatory::validateAndLoad(node_value, output, error));
+
+    // wrong size
+    YAML::Node node_size = YAML::Clone(node);
+    node_size["own_type"]["param5"].push_back(1);
+    ASSERT_FALSE(single_mandatory::validateAndLoad(node_size, output, error));
+    ASSERT_EQ(error, "ERROR in 'own_type/param5': Wrong size, should be 5");
+
+    // throwing version
+    ASSERT_THROW(single_mandatory::validateAndLoad(node_size), std::runtime_error);
+
+    // the input is not modified
+    ASSERT_FALSE(node["own_type"]["param4"]);
+}
+
+TEST(code_generator, expression)
+{
+    auto output = expression::validateAndLoad(YAML::LoadFile(ROOT_DIR + "/test/yaml/expression_input1.yaml"));
+
+    ASSERT_TRUE(output.enabled);
+    ASSERT_EQ(output.mode, "auto");
+    ASSERT_EQ(output.param_expr23, 23);
+    ASSERT_FALSE(output.optional_default_bool);
+    ASSERT_DOUBLE_EQ(output.optional_default_double, -1);
+
+    // expressions evaluated: missing fields mandatory by expression
+    auto node = YAML::LoadFile(ROOT_DIR + "/test/yaml/expression_input1.yaml");
+    node.remove("param_expr3");
+    expression::Expression output_wrong;
+    std::string            error;
+    ASSERT_FALSE(expression::validateAndLoad(node, output_wrong, error));
+    ASSERT_EQ(error, "ERROR in 'param_expr3': Missing mandatory field.");
+
+    // missing mandatory field used in an expression
+    ASSERT_FALSE(expression::validateAndLoad(
+        YAML::LoadFile(ROOT_DIR + "/test/yaml/expression_input_wrong1.yaml"), output_wrong, error));
+}
+
+TEST(code_generator, derived_not_supported)
+{
+    ASSERT_THROW(generateCode("sequence_derived", {ROOT_DIR + "/test/schema"}), std::runtime_error);
+}
+
+#if _EIGEN_FOUND == 1
+TEST(code_generator, eigen)
+{
+    auto node = YAML::Load("value: [1, 2, 3]\nprior:\n  mode: factor\n  factor_std: [0.1, 0.1, 0.1]");
+
+    auto output = StateP3d::validateAndLoad(node);
+
+    ASSERT_EQ(output.type, "StatePoint3d");
+    ASSERT_MATRIX_APPROX(output.value, Eigen::Vector3d(1, 2, 3), 1e-12);
+    ASSERT_EQ(output.prior.mode, "factor");
+    ASSERT_MATRIX_APPROX(output.prior.factor_std, Eigen::Vector3d(0.1, 0.1, 0.1), 1e-12);
+
+    node["value"] = YAML::Load("[1, 2]");
+    std::string        error;
+    StateP3d::StateP3d output_wrong;
+    ASSERT_FALSE(StateP3d::validateAndLoad(node, output_wrong, error));
+    ASSERT_EQ(error, "ERROR in 'value': Wrong type");
+}
+#endif
+
+TEST(code_generator, generateCode)
+{
+    auto code = generateCode("single_mandatory", {ROOT_DIR + "/test/schema"}, "my_namespace");
+
+    ASSERT_NE(code.find("namespace my_namespace"), std::string::npos);
+    ASSERT_NE(code.find("struct SingleMandatory"), std::string::npos);
+    ASSERT_NE(code.find("struct BaseInput"), std::string::npos);
+    ASSERT_EQ(code.find("Eigen"), std::string::npos);
+
+    ASSERT_THROW(generateCode("non_existing_schema", {ROOT_DIR + "/test/schema"}), std::runtime_error);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -2,7 +2,9 @@
 #include "yaml-schema-cpp/yaml_conversion.hpp"
 #include <yaml-cpp/yaml.h>
 #include <eigen3/Eigen/Dense>
+#include <clocale>
 #include <iostream>
+#include <locale>
 
 using namespace Eigen;
 
@@ -119,6 +121,80 @@ TEST(MapYaml, encode)
     std::cout << n3 << std::endl;
 }
 
+TEST(MapYaml, bulk)
+{
+    // roundtrip (also row major and non-double scalars)
+    MatrixXd   M = MatrixXd::Random(64, 64);
+    YAML::Node n_sized;
+    n_sized.push_back(YAML::Load("[64, 64]"));
+    n_sized.push_back(YAML::Node(M));
+    ASSERT_MATRIX_APPROX(n_sized.as<MatrixXd>(), M, 0);  // encoded with max_digits10
+
+    typedef Matrix<double, 2, 3, RowMajor> Matrix23RowMajor;
+    Matrix23RowMajor                       M23r;
+    M23r << 1, 2, 3, 4, 5, 6;
+    ASSERT_MATRIX_APPROX(YAML::Load("[1, 2, 3, 4, 5, 6]").as<Matrix23RowMajor>(), M23r, 1e-12);
+
+    Matrix3f M3f = Matrix3f::Random();
+    ASSERT_TRUE(YAML::Node(M3f).as<Matrix3f>() == M3f);
+
+    Vector3i v3i(1, -2, 3);
+    ASSERT_TRUE(YAML::Load("[1, -2, 3]").as<Vector3i>() == v3i);
+    ASSERT_EQ(YAML::Node(v3i)[1].Scalar(), "-2");
+
+    // values not parsed by the fast parser
+    auto v_special = YAML::Load("[.inf, -.inf, 1e3, 010, +2.5]").as<Matrix<double, 5, 1>>();
+    ASSERT_TRUE(std::isinf(v_special(0)) and v_special(0) > 0);
+    ASSERT_TRUE(std::isinf(v_special(1)) and v_special(1) < 0);
+    ASSERT_DOUBLE_EQ(v_special(2), 1e3);
+    ASSERT_DOUBLE_EQ(v_special(3), 10);
+    ASSERT_DOUBLE_EQ(v_special(4), 2.5);
+    ASSERT_TRUE(YAML::Load("[010, 0x10, -010]").as<Vector3i>() == Vector3i(8, 16, -8));  // same as yaml-cpp
+    ASSERT_EQ(YAML::Node(Vector2d(NAN, INFINITY))[0].Scalar(), ".nan");
+
+    // wrong values
+    Vector3d v3;
+    ASSERT_FALSE(YAML::convert<Vector3d>::decode(YAML::Load("[1, a, 3]"), v3));
+    ASSERT_FALSE(YAML::convert<Vector3i>::decode(YAML::Load("[1, 2.5, 3]"), v3i));
+    ASSERT_FALSE(YAML::convert<Vector3d>::decode(YAML::Load("[1, [2], 3]"), v3));
+    ASSERT_THROW(YAML::Load("[1, a, 3]").as<Vector3d>(), YAML::BadConversion);
+
+    // quaternion
+    Quaterniond q = YAML::Load("[0, 0, 0.7071, 0.7071]").as<Quaterniond>();
+    ASSERT_DOUBLE_EQ(q.z(), 0.7071);
+    ASSERT_DOUBLE_EQ(q.w(), 0.7071);
+    ASSERT_THROW(YAML::Load("[0, 0, a, 1]").as<Quaterniond>(), YAML::BadConversion);
+}
+
+// decimal comma, as in many locales
+struct CommaNumpunct : std::numpunct<char>
+{
+    char do_decimal_point() const override { return ','; }
+};
+
+TEST(MapYaml, encode_locale)
+{
+    Vector3d v(0.5, 1.0 / 3.0, -2.5e-300);
+
+    // not affected by the global locale
+    auto locale_global = std::locale::global(std::locale(std::locale::classic(), new CommaNumpunct));
+    auto node_global   = YAML::Node(v);
+    std::locale::global(locale_global);
+    ASSERT_EQ(node_global[0].Scalar(), "0.5");
+    ASSERT_TRUE(node_global.as<Vector3d>() == v);
+
+    // nor by the C locale (if any locale with decimal comma is installed)
+    for (auto name : {"de_DE.UTF-8", "es_ES.UTF-8", "fr_FR.UTF-8"})
+    {
+        std::string locale_c = std::setlocale(LC_NUMERIC, nullptr);
+        if (not std::setlocale(LC_NUMERIC, name)) continue;
+        auto node_c = YAML::Node(v);
+        std::setlocale(LC_NUMERIC, locale_c.c_str());
+        ASSERT_EQ(node_c[0].Scalar(), "0.5");
+        ASSERT_TRUE(node_c.as<Vector3d>() == v);
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
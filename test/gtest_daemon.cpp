@@ -0,0 +1,175 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/yaml_daemon.hpp"
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+// request retrying until the daemon is listening
+YAML::Node requestRetrying(const std::string& socket_path, const YAML::Node& request)
+{
+    for (auto i = 0; i < 50; i++)
+    {
+        try
+        {
+            return requestDaemon(socket_path, request);
+        }
+        catch (const std::runtime_error&)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    return requestDaemon(socket_path, request);
+}
+
+TEST(daemon, requests)
+{
+    auto socket_path = (filesystem::temp_directory_path() / "yaml_schema_cpp_gtest_daemon.sock").string();
+
+    YamlDaemon  daemon({ROOT_DIR + "/test/schema"}, socket_path);
+    std::thread daemon_thread(&YamlDaemon::run, &daemon);
+
+    // validate
+    YAML::Node request;
+    request["command"] = "validate";
+    request["schema"]  = "base_input";
+    request["input"]   = ROOT_DIR + "/test/yaml/base_input.yaml";
+    auto response      = requestRetrying(socket_path, request);
+    ASSERT_TRUE(response["ok"].as<bool>());
+    EXPECT_TRUE(response["valid"].as<bool>());
+    EXPECT_DOUBLE_EQ(response["node"]["map1"]["param3"].as<double>(), 3.5);
+
+    request["input"] = ROOT_DIR + "/test/yaml/base_input_wrong1.yaml";
+    response         = requestDaemon(socket_path, request);
+    ASSERT_TRUE(response["ok"].as<bool>());
+    EXPECT_FALSE(response["valid"].as<bool>());
+    EXPECT_NE(response["log"].as<std::string>().find("ERROR"), std::string::npos);
+
+    // generate
+    YAML::Node request_generate;
+    request_generate["command"] = "generate";
+    request_generate["schema"]  = "base_input";
+    response                    = requestDaemon(socket_path, request_generate);
+    ASSERT_TRUE(response["ok"].as<bool>());
+    EXPECT_NE(response["template"].as<std::string>().find("param1"), std::string::npos);
+
+    // diff
+    YAML::Node request_diff;
+    request_diff["command"] = "diff";
+    request_diff["schema"]  = "base_input";
+    request_diff["old"]     = ROOT_DIR + "/test/yaml/base_input.yaml";
+    request_diff["new"]     = ROOT_DIR + "/test/yaml/duplicated_input.yaml";
+    response                = requestDaemon(socket_path, request_diff);
+    ASSERT_TRUE(response["ok"].as<bool>());
+    ASSERT_TRUE(response["diff"].IsSequence());
+    EXPECT_FALSE(response["diff"].size() == 0);
+
+    // errors
+    request["input"] = ROOT_DIR + "/test/yaml/not_existing.yaml";
+    response         = requestDaemon(socket_path, request);
+    EXPECT_FALSE(response["ok"].as<bool>());
+    EXPECT_NE(response["error"].as<std::string>().find("not_existing.yaml"), std::string::npos);
+
+    YAML::Node request_unknown;
+    request_unknown["command"] = "unknown";
+    EXPECT_FALSE(requestDaemon(socket_path, request_unknown)["ok"].as<bool>());
+
+    // stop
+    YAML::Node request_stop;
+    request_stop["command"] = "stop";
+    EXPECT_TRUE(requestDaemon(socket_path, request_stop)["ok"].as<bool>());
+    daemon_thread.join();
+    EXPECT_FALSE(filesystem::exists(socket_path));
+    EXPECT_THROW(requestDaemon(socket_path, request), std::runtime_error);
+}
+
+TEST(daemon, concurrent_clients)
+{
+    auto socket_path = (filesystem::temp_directory_path() / "yaml_schema_cpp_gtest_daemon_concurrent.sock").string();
+
+    YamlDaemon  daemon({ROOT_DIR + "/test/schema"}, socket_path);
+    std::thread daemon_thread(&YamlDaemon::run, &daemon);
+
+    YAML::Node request;
+    request["command"] = "validate";
+    request["schema"]  = "base_input";
+    request["input"]   = ROOT_DIR + "/test/yaml/base_input.yaml";
+    requestRetrying(socket_path, request);
+
+    std::vector<std::thread> clients;
+    std::atomic<int>         valid(0);
+    for (auto i = 0; i < 8; i++)
+        clients.emplace_back([&]() {
+            YAML::Node request_client;
+            request_client["command"] = "validate";
+            request_client["schema"]  = "base_input";
+            request_client["input"]   = ROOT_DIR + "/test/yaml/base_input.yaml";
+            for (auto j = 0; j < 5; j++)
+            {
+                auto response = requestDaemon(socket_path, request_client);
+                if (response["ok"].as<bool>() and response["valid"].as<bool>()) valid++;
+            }
+        });
+    for (auto& client : clients) client.join();
+    EXPECT_EQ(valid, 40);
+
+    daemon.stop();
+    daemon_thread.join();
+}
+
+TEST(daemon, existing_socket_path)
+{
+    auto socket_path = (filesystem::temp_directory_path() / "yaml_schema_cpp_gtest_daemon_existing.sock").string();
+    filesystem::remove(socket_path);
+
+    YAML::Node request;
+    request["command"] = "unknown";
+
+    // not a socket: not removed
+    std::ofstream(socket_path) << "not a socket";
+    YamlDaemon daemon_file({ROOT_DIR + "/test/schema"}, socket_path);
+    EXPECT_THROW(daemon_file.run(), std::runtime_error);
+    EXPECT_TRUE(filesystem::exists(socket_path));
+    filesystem::remove(socket_path);
+
+    // socket left by a process that did not stop: replaced
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_EQ(bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    close(fd);
+    ASSERT_TRUE(filesystem::exists(socket_path));
+
+    YamlDaemon  daemon({ROOT_DIR + "/test/schema"}, socket_path);
+    std::thread daemon_thread(&YamlDaemon::run, &daemon);
+    EXPECT_FALSE(requestRetrying(socket_path, request)["ok"].as<bool>());
+
+    // socket of a running daemon: not replaced
+    YamlDaemon daemon_other({ROOT_DIR + "/test/schema"}, socket_path);
+    EXPECT_THROW(daemon_other.run(), std::runtime_error);
+    EXPECT_FALSE(requestDaemon(socket_path, request)["ok"].as<bool>());
+
+    daemon.stop();
+    daemon_thread.join();
+    EXPECT_FALSE(filesystem::exists(socket_path));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/yaml_diff.hpp"
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+const DiffEntry* findDiff(const std::vector<DiffEntry>& diffs, const std::string& path)
+{
+    for (auto& diff : diffs)
+        if (diff.path == path) return &diff;
+    return nullptr;
+}
+
+TEST(diff, identical)
+{
+    auto node = YAML::Load("own_type: {map1: {param1: 1, param2: string}, param5: [5, 6, -1, -7, 0]}");
+
+    ASSERT_TRUE(diffNodes(node, YAML::Clone(node), "single_mandatory.schema", {ROOT_DIR}).empty());
+    ASSERT_TRUE(diffNodesAutoType(node, YAML::Clone(node)).empty());
+}
+
+TEST(diff, schema)
+{
+    auto node_old = YAML::Load(
+        "own_type: {map1: {param1: 1, param2: string, param3: 3.5}, param4: hello, param5: [5, 6, -1, -7, 0]}\n"
+        "extra: {a: 1, b: 2}");
+    auto node_new = YAML::Load(
+        "own_type: {map1: {param2: strong, param3: 3.50, param1: 1}, param5: [5, 6, -1, -7, 1], param6: 1.56}\n"
+        "extra: {a: 1, b: 3}");
+
+    auto diffs = diffNodes(node_old, node_new, "single_mandatory.schema", {ROOT_DIR});
+
+    ASSERT_EQ(diffs.size(), 5);
+
+    auto diff = findDiff(diffs, "own_type/map1/param2");
+    ASSERT_TRUE(diff);
+    ASSERT_EQ(diff->diff_type, DiffType::CHANGED);
+    ASSERT_EQ(diff->type, "string");
+    ASSERT_EQ(diff->old_value.as<std::string>(), "string");
+    ASSERT_EQ(diff->new_value.as<std::string>(), "strong");
+
+    diff = findDiff(diffs, "own_type/param4");
+    ASSERT_TRUE(diff);
+    ASSERT_EQ(diff->diff_type, DiffType::REMOVED);
+    ASSERT_FALSE(diff->new_value.IsDefined());
+
+    diff = findDiff(diffs, "own_type/param5");
+    ASSERT_TRUE(diff);
+    ASSERT_EQ(diff->diff_type, DiffType::CHANGED);
+    ASSERT_EQ(diff->type, "int[5]");
+
+    diff = findDiff(diffs, "own_type/param6");
+    ASSERT_TRUE(diff);
+    ASSERT_EQ(diff->diff_type, DiffType::ADDED);
+    ASSERT_DOUBLE_EQ(diff->new_value.as<double>(), 1.56);
+
+    // not in schema
+    diff = findDiff(diffs, "extra/b");
+    ASSERT_TRUE(diff);
+    ASSERT_EQ(diff->diff_type, DiffType::CHANGED);
+    ASSERT_EQ(diff->type, "");
+}
+
+TEST(diff, string_fields)
+{
+    // numeric-looking strings are compared as text
+    for (auto values : std::vector<std::pair<std::string, std::string>>{{"1.0", "1.00"}, {"007", "7"}, {"1000", "1e3"}})
+    {
+        auto node_old = YAML::Load("own_type: {map1: {param1: 1, param2: '" + values.first + "', param3: 3.5}}\n"
+                                   "extra: 1000");
+        auto node_new = YAML::Load("own_type: {map1: {param1: 1, param2: '" + values.second + "', param3: 3.50}}\n"
+                                   "extra: 1e3");
+
+        auto diffs = diffNodes(node_old, node_new, "single_mandatory.schema", {ROOT_DIR});
+        ASSERT_EQ(diffs.size(), 1) << values.first << " -> " << values.second;
+        EXPECT_EQ(diffs.front().path, "own_type/map1/param2");
+        EXPECT_EQ(diffs.front().type, "string");
+    }
+}
+
+TEST(diff, sequence_own_type)
+{
+    auto node_old = YAML::Load("own_type: [{map1: {param1: 1, param2: string}}, {map1: {param1: 2, param2: string}}]");
+    auto node_new = YAML::Load("own_type: [{map1: {param1: 1, param2: string}}, {map1: {param1: 3, param2: string}}]");
+
+    auto diffs = diffNodes(node_old, node_new, "sequence_mandatory.schema", {ROOT_DIR});
+
+    ASSERT_EQ(diffs.size(), 1);
+    ASSERT_EQ(diffs.front().path, "own_type[1]/map1/param1");
+    ASSERT_EQ(diffs.front().type, "int");
+    ASSERT_EQ(diffs.front().old_value.as<int>(), 2);
+    ASSERT_EQ(diffs.front().new_value.as<int>(), 3);
+}
+
+TEST(diff, auto_type)
+{
+    auto diffs = diffNodesAutoType(YAML::Load("{a: 1, b: [1, 2], c: {d: x}}"),
+                                   YAML::Load("{a: 1.0, b: [1, 3], c: {e: x}}"));
+
+    ASSERT_EQ(diffs.size(), 3);
+    ASSERT_EQ(findDiff(diffs, "b[1]")->diff_type, DiffType::CHANGED);
+    ASSERT_EQ(findDiff(diffs, "c/d")->diff_type, DiffType::REMOVED);
+    ASSERT_EQ(findDiff(diffs, "c/e")->diff_type, DiffType::ADDED);
+}
+
+TEST(diff, wrong_schema)
+{
+    ASSERT_THROW(diffNodes(YAML::Node(), YAML::Node(), "non_existing.schema", {ROOT_DIR}), std::runtime_error);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -123,6 +123,55 @@ TEST(TestExpression, evalExpressionYaml)
                  std::runtime_error);
 }
 
+TEST(TestExpression, evalExpressionReused)
+{
+    // same expression evaluated for different inputs (compiled once, again if variable types change)
+    ASSERT_TRUE(evalExpression("$param > 2", YAML::Load("param: 3")));
+    ASSERT_FALSE(evalExpression("$param > 2", YAML::Load("param: 1")));
+    ASSERT_FALSE(evalExpression("$param > 2", YAML::Load("param: true")));
+    ASSERT_THROW(evalExpression("$param > 2", YAML::Load("other: 3")), std::runtime_error);
+    ASSERT_TRUE(evalExpression("$param > 2", YAML::Load("param: 5.5")));
+
+    ASSERT_TRUE(evalExpression("$mode == 'auto'", YAML::Load("mode: auto")));
+    ASSERT_FALSE(evalExpression("$mode == 'auto'", YAML::Load("mode: automatic")));
+    ASSERT_FALSE(evalExpression("$mode == 'auto'", YAML::Load("mode: a")));
+    ASSERT_TRUE(evalExpression("$mode == 'auto'", YAML::Load("mode: auto")));
+}
+
+TEST(TestExpression, evalExpressionBatch)
+{
+    std::vector<YAML::Node> nodes_input;
+    for (auto i = 0; i < 1000; i++)
+    {
+        YAML::Node node_input;
+        node_input["enabled"]   = i % 2 == 0;
+        node_input["param_int"] = i % 7;
+        node_input["mode"]      = i % 3 == 0 ? "auto" : (i % 3 == 1 ? "manual" : "a");
+        nodes_input.push_back(node_input);
+    }
+    // numeric variables given as double or bool
+    nodes_input[10]["param_int"] = 2.5;
+    nodes_input[20]["param_int"] = true;
+
+    for (auto expression : {"$enabled and param_int < 3",
+                            "$not(enabled) or mode == 'auto'",
+                            "$mode <> 'manual' and param_int >= 2"})
+    {
+        auto results = evalExpressionBatch(expression, nodes_input);
+        ASSERT_EQ(results.size(), nodes_input.size());
+        for (auto i = 0; i < nodes_input.size(); i++)
+            EXPECT_EQ(results[i], evalExpression(expression, nodes_input[i])) << expression << " node " << i;
+    }
+
+    EXPECT_TRUE(evalExpressionBatch("$enabled", {}).empty());
+
+    // first failing node
+    nodes_input[5].remove("param_int");
+    EXPECT_THROW(evalExpressionBatch("$param_int > 3", nodes_input), std::runtime_error);
+    nodes_input[0].remove("param_int");
+    EXPECT_THROW(evalExpressionBatch("$param_int > 3", nodes_input), std::runtime_error);
+}
+
 TEST(TestExpression, applySchema)
 {
     std::vector<std::string> input_yamls{ROOT_DIR + "/test/yaml/expression_input1.yaml",
@@ -146,6 +146,98 @@ TEST(flatten_schema, sequence_follow)
     ASSERT_TRUE(compareNodesAutoType(schema_flatten, gt_node));  // compareNodesAutoType validated at gtest_yaml_utils
 }
 
+TEST(flatten_parallel, same_as_sequential)
+{
+    std::vector<std::string> cases{"flatten_merge", "flatten_override", "flatten_recursive", "flatten_relative_path",
+                                   "flatten_sequence_follow"};
+    for (auto test_case : cases)
+    {
+        // input yaml
+        auto       path_yaml     = ROOT_DIR + "/test/yaml/flatten/" + test_case + ".yaml";
+        YAML::Node node_sequence = YAML::LoadFile(path_yaml);
+        YAML::Node node_parallel = YAML::LoadFile(path_yaml);
+        flattenNode(node_sequence, ROOT_DIR + "/test/yaml/flatten", {}, false, true);
+        flattenNode(node_parallel, ROOT_DIR + "/test/yaml/flatten", {}, false, true, true);
+        EXPECT_EQ(YAML::Dump(node_sequence), YAML::Dump(node_parallel)) << test_case;
+
+        // schema
+        auto       path_schema          = ROOT_DIR + "/test/schema/flatten/" + test_case + ".schema";
+        YAML::Node node_schema_sequence = YAML::LoadFile(path_schema);
+        YAML::Node node_schema_parallel = YAML::LoadFile(path_schema);
+        flattenNode(node_schema_sequence, ROOT_DIR + "/test/schema/flatten", {ROOT_DIR + "/test/schema"}, true, true);
+        flattenNode(
+            node_schema_parallel, ROOT_DIR + "/test/schema/flatten", {ROOT_DIR + "/test/schema"}, true, true, true);
+        EXPECT_EQ(YAML::Dump(node_schema_sequence), YAML::Dump(node_schema_parallel)) << test_case;
+    }
+}
+
+TEST(flatten_parallel, order_and_errors)
+{
+    // later follows override the former ones, as sequentially
+    YAML::Node node =
+        YAML::Load("follow: [base_input.yaml, flatten/flatten_override_gt.yaml, simple_type_default.yaml]");
+    YAML::Node node_parallel = Clone(node);
+    flattenNode(node, ROOT_DIR + "/test/yaml", {}, false, true);
+    flattenNode(node_parallel, ROOT_DIR + "/test/yaml", {}, false, true, true);
+    EXPECT_EQ(YAML::Dump(node), YAML::Dump(node_parallel));
+
+    // the first error (in order) is thrown
+    node = YAML::Load("follow: [base_input.yaml, non_existing1.yaml, non_existing2.yaml]");
+    try
+    {
+        flattenNode(node, ROOT_DIR + "/test/yaml", {}, false, true, true);
+        FAIL() << "flattenNode should throw";
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_NE(std::string(e.what()).find("non_existing1.yaml"), std::string::npos) << e.what();
+    }
+
+    // not allowed override
+    node = YAML::Load("follow: [base_input.yaml, base_input.yaml]");
+    EXPECT_THROW(flattenNode(node, ROOT_DIR + "/test/yaml", {}, false, false, true), std::runtime_error);
+}
+
+TEST(flatten_yaml, cycle)
+{
+    for (auto parallel : {false, true})
+    {
+        YAML::Node node = YAML::Load("follow: flatten/flatten_cycle_a.yaml");
+        try
+        {
+            flattenNode(node, ROOT_DIR + "/test/yaml", {}, false, true, parallel);
+            FAIL() << "flattenNode should throw";
+        }
+        catch (const std::runtime_error& e)
+        {
+            EXPECT_NE(std::string(e.what()).find("cyclic"), std::string::npos) << e.what();
+            EXPECT_NE(std::string(e.what()).find("flatten_cycle_b.yaml"), std::string::npos) << e.what();
+        }
+    }
+}
+
+TEST(flatten_yaml, diamond)
+{
+    for (auto parallel : {false, true})
+    {
+        YAML::Node node = YAML::Load("follow: flatten/flatten_diamond.yaml");
+        flattenNode(node, ROOT_DIR + "/test/yaml", {}, false, true, parallel);
+
+        // the bottom file is included from both branches
+        ASSERT_TRUE(node["left"]["bottom"]);
+        ASSERT_TRUE(node["right"]["bottom"]);
+        EXPECT_EQ(node["left"]["param_left"].as<int>(), 1);
+        EXPECT_EQ(node["right"]["param_right"].as<int>(), 2);
+        EXPECT_EQ(YAML::Dump(node["left"]["bottom"]), YAML::Dump(node["right"]["bottom"]));
+
+        // not shared between branches
+        node["left"]["bottom"]["param3"] = 33;
+        node["left"]["bottom"]["param4"].push_back(3);
+        EXPECT_EQ(node["right"]["bottom"]["param3"].as<int>(), 3);
+        EXPECT_EQ(node["right"]["bottom"]["param4"].size(), 2);
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,7 +1,10 @@
+#include <fstream>
+
 #include "gtest/utils_gtest.h"
 #include "yaml-schema-cpp/internal/config.h"
 #include "yaml-schema-cpp/filesystem_wrapper.hpp"
 #include "yaml-schema-cpp/yaml_generator.hpp"
+#include "yaml-schema-cpp/yaml_utils.hpp"
 
 std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
 
@@ -58,7 +61,85 @@ TEST(generator, sequence_of_derived)
               << YAML::LoadFile(ROOT_DIR + "/test/schema/type_derived/sequence_derived.schema") << std::endl
               << std::endl;
 
-    std::cout << "GENERATED YAML:\n" << generateYaml("sequence_derived.schema", {ROOT_DIR}) << std::endl;
+    auto node = generateYaml("sequence_derived.schema", {ROOT_DIR});
+    std::cout << "GENERATED YAML:\n" << node << std::endl;
+
+    ASSERT_EQ(node["sensors"].size(), 2);
+    ASSERT_EQ(node["processors"].size(), 3);
+    ASSERT_TRUE(node["processors"][2]["type"]);
+}
+
+TEST(generator, sequence_of_own_type)
+{
+    auto node = generateYaml("sequence_mandatory.schema", {ROOT_DIR});
+
+    // custom type generated once and copied in each element
+    ASSERT_EQ(node["own_type"].size(), 2);
+    EXPECT_EQ(YAML::Dump(node["own_type"][0]), YAML::Dump(node["own_type"][1]));
+
+    // elements are independent
+    node["own_type"][0]["param4"] = "modified";
+    EXPECT_NE(YAML::Dump(node["own_type"][0]), YAML::Dump(node["own_type"][1]));
+}
+
+TEST(generator, stream_template)
+{
+    for (auto name_schema : {"test1.schema",
+                             "expression.schema",
+                             "test2.schema",
+                             "single_mandatory.schema",
+                             "type_derived_final.schema",
+                             "sequence_derived.schema"})
+    {
+        std::stringstream template_ss;
+        generateTemplate(template_ss, name_schema, {ROOT_DIR});
+        std::cout << "TEMPLATE " << name_schema << ":\n" << template_ss.str() << std::endl;
+
+        // same fields than generateYaml()
+        auto node_template = YAML::Load(template_ss.str());
+        auto node_yaml     = generateYaml(name_schema, {ROOT_DIR});
+        ASSERT_EQ(node_template.size(), node_yaml.size()) << name_schema;
+        for (auto node_yaml_child : node_yaml)
+            EXPECT_TRUE(node_template[node_yaml_child.first.as<std::string>()]) << name_schema;
+    }
+
+    // comments are yaml comments
+    std::stringstream template_ss;
+    generateTemplate(template_ss, "sequence_derived.schema", {ROOT_DIR});
+    auto node_template = YAML::Load(template_ss.str());
+    EXPECT_EQ(node_template["sensors"].size(), 2);
+    EXPECT_EQ(node_template["processors"].size(), 3);
+    EXPECT_EQ(node_template["processors"][2]["type"].as<std::string>(), "DerivedType");
+    EXPECT_NE(template_ss.str().find("# DOC String corresponding"), std::string::npos);
+}
+
+TEST(generator, batch_templates)
+{
+    std::string temporary_folder = ROOT_DIR + "/test/temp_folder_batch";
+    if (not filesystem::exists(temporary_folder)) filesystem::create_directory(temporary_folder);
+
+    std::stringstream log;
+    EXPECT_TRUE(generateTemplates(temporary_folder, {ROOT_DIR + "/test/schema/type_derived"}, log)) << log.str();
+
+    // one template per schema, same as generateTemplate()
+    auto schemas = getAllSchemas({ROOT_DIR + "/test/schema/type_derived"});
+    ASSERT_FALSE(schemas.empty());
+    for (auto schema : schemas)
+    {
+        auto path_template = temporary_folder + "/" + filesystem::path(schema).stem().string() + "_template.yaml";
+        ASSERT_TRUE(filesystem::exists(path_template)) << path_template;
+
+        std::ifstream     template_file(path_template);
+        std::stringstream template_batch, template_single;
+        template_batch << template_file.rdbuf();
+        generateTemplate(template_single, schema, {ROOT_DIR + "/test/schema/type_derived"});
+        EXPECT_EQ(template_batch.str(), template_single.str()) << schema;
+    }
+
+    // not existing output folder
+    EXPECT_FALSE(generateTemplates(temporary_folder + "/not_existing", {ROOT_DIR + "/test/schema/type_derived"}, log));
+
+    filesystem::remove_all(temporary_folder);
 }
 
 TEST(generator, file_template)
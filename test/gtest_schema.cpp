@@ -46,6 +46,34 @@ TEST(schema, nontrivial_options_default_value)
     std::cout << log.str() << std::endl;
 }
 
+TEST(schema, resolve_type_schema)
+{
+    std::vector<std::string> folders{ROOT_DIR + "/test/schema/folder_schema"};
+    std::stringstream        log;
+
+    // trivial type: no schema
+    YAML::Node node_schema_type;
+    EXPECT_TRUE(resolveTypeSchema("double[3][]", folders, node_schema_type, log));
+    EXPECT_FALSE(node_schema_type.IsDefined());
+
+    // custom type: lowest element type schema loaded
+    EXPECT_TRUE(resolveTypeSchema("simple_type[][2]", folders, node_schema_type, log));
+    ASSERT_TRUE(node_schema_type.IsDefined());
+    EXPECT_TRUE(node_schema_type["int_param"]);
+
+    // options of custom type checked against the resolved schema
+    YAML::Node node_schema = loadSchema("nontrivial_options_default_value", folders, log);
+    ASSERT_TRUE(node_schema.IsDefined());
+    YAML::Node node_spec = node_schema["map1"]["param_simple_options"];
+    EXPECT_NO_THROW(checkSchemaOptions(node_spec, "param_simple_options", node_schema, node_schema_type, folders));
+    YAML::Node node_default = node_schema["map1"]["param_simple_default"][DEFAULT];
+    EXPECT_TRUE(isInOptionsResolved(node_default, node_spec[OPTIONS], "simple_type", node_schema_type, folders));
+
+    // not existing type
+    EXPECT_FALSE(resolveTypeSchema("not_existing_type[]", folders, node_schema_type, log));
+    EXPECT_FALSE(node_schema_type.IsDefined());
+}
+
 TEST(schema, wrong)
 {
     std::list<std::string> wrong_schemas{"not_base",
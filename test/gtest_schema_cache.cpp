@@ -0,0 +1,186 @@
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/schema_cache.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/yaml_server.hpp"
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+TEST(schema_cache, compiled_once)
+{
+    std::stringstream log;
+
+    auto compiled1 = getCompiledSchema("base_input", {ROOT_DIR + "/test/schema/folder_schema"}, log);
+    auto compiled2 = getCompiledSchema("base_input", {ROOT_DIR + "/test/schema/folder_schema"}, log);
+    ASSERT_TRUE(compiled1);
+    EXPECT_EQ(compiled1, compiled2);
+    EXPECT_TRUE(compiled1->node.IsMap());
+    EXPECT_EQ(compiled1->options.size(), 3);
+
+    // different override --> different compiled schema
+    auto compiled3 = getCompiledSchema("base_input", {ROOT_DIR + "/test/schema/folder_schema"}, log, false);
+    ASSERT_TRUE(compiled3);
+    EXPECT_NE(compiled1, compiled3);
+
+    // not existing
+    EXPECT_FALSE(getCompiledSchema("not_existing_schema", {ROOT_DIR + "/test/schema/folder_schema"}, log));
+
+    // cleared
+    clearSchemaCache();
+    auto compiled4 = getCompiledSchema("base_input", {ROOT_DIR + "/test/schema/folder_schema"}, log);
+    EXPECT_NE(compiled1, compiled4);
+}
+
+TEST(schema_cache, options_set_trivial)
+{
+    std::stringstream log;
+
+    auto compiled = getCompiledSchema("base_input", {ROOT_DIR + "/test/schema/folder_schema"}, log);
+    ASSERT_TRUE(compiled);
+
+    // string options
+    auto options_string = compiled->findOptions(compiled->node["map1"]["param2"][OPTIONS]);
+    ASSERT_TRUE(options_string);
+    EXPECT_TRUE(options_string->contains(YAML::Load("strong")));
+    EXPECT_TRUE(options_string->contains(YAML::Load("\"streng\"")));
+    EXPECT_FALSE(options_string->contains(YAML::Load("strang")));
+
+    // double options
+    auto options_double = compiled->findOptions(compiled->node["param6"][OPTIONS]);
+    ASSERT_TRUE(options_double);
+    EXPECT_TRUE(options_double->contains(YAML::Load("1.56")));
+    EXPECT_TRUE(options_double->contains(YAML::Load("0.0")));
+    EXPECT_TRUE(options_double->contains(YAML::Load("-0")));
+    EXPECT_TRUE(options_double->contains(YAML::Load("314e-2")));
+    EXPECT_FALSE(options_double->contains(YAML::Load("3.1")));
+    EXPECT_FALSE(options_double->contains(YAML::Load("pi")));
+
+    // sequence options
+    auto options_seq = compiled->findOptions(compiled->node["param7"][OPTIONS]);
+    ASSERT_TRUE(options_seq);
+    EXPECT_TRUE(options_seq->contains(YAML::Load("[0.0, 2, 3e0]")));
+    EXPECT_FALSE(options_seq->contains(YAML::Load("[0, 2]")));
+    EXPECT_FALSE(options_seq->contains(YAML::Load("[0, 2, 4]")));
+
+    // not an options node of a compiled schema
+    EXPECT_FALSE(compiled->findOptions(YAML::Load("[0, 1.56, 3.14]")));
+}
+
+TEST(schema_cache, options_set_nontrivial)
+{
+    std::vector<std::string> folders{ROOT_DIR + "/test/schema/folder_schema", ROOT_DIR + "/test/yaml"};
+    std::stringstream        log;
+
+    auto compiled = getCompiledSchema("nontrivial_options_default_value", folders, log);
+    ASSERT_TRUE(compiled);
+
+    auto options = compiled->findOptions(compiled->node["map1"]["param_simple_options"][OPTIONS]);
+    ASSERT_TRUE(options);
+
+    // optional_bool_param default is true
+    EXPECT_TRUE(options->contains(YAML::Load("{int_param: 3, string_param: strong, optional_bool_param: false}")));
+    EXPECT_TRUE(options->contains(YAML::Load("{string_param: streng, int_param: 0, optional_bool_param: true}")));
+    EXPECT_FALSE(options->contains(YAML::Load("{int_param: 3, string_param: strong, optional_bool_param: true}")));
+    EXPECT_FALSE(options->contains(YAML::Load("{int_param: 3, string_param: strong}")));
+}
+
+TEST(schema_cache, canonical_key)
+{
+    std::string key1, key2;
+
+    EXPECT_TRUE(canonicalKeyTrivial(YAML::Load("1000"), "double", key1));
+    EXPECT_TRUE(canonicalKeyTrivial(YAML::Load("1e3"), "double", key2));
+    EXPECT_EQ(key1, key2);
+
+    key1.clear();
+    EXPECT_TRUE(canonicalKeyTrivial(YAML::Load("1000"), "int", key1));
+    EXPECT_FALSE(canonicalKeyTrivial(YAML::Load("1e3"), "int", key1));
+
+    key1.clear();
+    key2.clear();
+    EXPECT_TRUE(canonicalKey(YAML::Load("[a, bc]"), "string[]", YAML::Node(), {}, key1));
+    EXPECT_TRUE(canonicalKey(YAML::Load("[ab, c]"), "string[2]", YAML::Node(), {}, key2));
+    EXPECT_NE(key1, key2);
+
+    key1.clear();
+    EXPECT_FALSE(canonicalKey(YAML::Load("[a, b, c]"), "string[2]", YAML::Node(), {}, key1));
+}
+
+TEST(schema_cache, followed_modified)
+{
+    auto folder = filesystem::temp_directory_path() / "yaml_schema_cpp_gtest_schema_cache";
+    filesystem::create_directories(folder);
+    std::ofstream((folder / "cache_root.schema").string()) << "follow: cache_followed.schema\n";
+    std::ofstream((folder / "cache_followed.schema").string())
+        << "param: {_type: int, _mandatory: false, _default: 1, _doc: a param}\n";
+
+    std::stringstream log;
+    auto              compiled1 = getCompiledSchema("cache_root", {folder.string()}, log);
+    ASSERT_TRUE(compiled1);
+    EXPECT_EQ(compiled1->files.size(), 2);
+    EXPECT_EQ(compiled1->node["param"][DEFAULT].as<int>(), 1);
+
+    // modify the followed file
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::ofstream((folder / "cache_followed.schema").string())
+        << "param: {_type: int, _mandatory: false, _default: 2, _doc: a param}\n";
+
+    // not checked again within the check interval
+    setSchemaCacheCheckInterval(3600);
+    EXPECT_EQ(getCompiledSchema("cache_root", {folder.string()}, log), compiled1);
+
+    // checked
+    setSchemaCacheCheckInterval(0);
+    auto compiled2 = getCompiledSchema("cache_root", {folder.string()}, log);
+    ASSERT_TRUE(compiled2);
+    EXPECT_NE(compiled2, compiled1);
+    EXPECT_EQ(compiled2->node["param"][DEFAULT].as<int>(), 2);
+    EXPECT_EQ(getCompiledSchema("cache_root", {folder.string()}, log), compiled2);
+
+    setSchemaCacheCheckInterval(1);
+    filesystem::remove_all(folder);
+}
+
+TEST(schema_cache, prefetch)
+{
+    clearSchemaCache();
+
+    // own types referenced in TYPE
+    auto prefetched = prefetchSchemas("sequence_mandatory", {ROOT_DIR + "/test/schema"});
+    EXPECT_TRUE(prefetched.get());
+
+    YamlServer server({ROOT_DIR + "/test/schema"}, ROOT_DIR + "/test/yaml/own_type/sequence_mandatory.yaml");
+    EXPECT_TRUE(server.applySchema("sequence_mandatory"));
+
+    // not existing
+    EXPECT_FALSE(prefetchSchemas("not_existing_schema", {ROOT_DIR + "/test/schema"}).get());
+}
+
+#if _EIGEN_FOUND == 1
+TEST(schema_cache, prefetch_complex_case)
+{
+    clearSchemaCache();
+
+    // follow, BASE of derived types and own types
+    // false: the BASE 'LandmarkBase' (in MapBase.schema) does not exist, the rest are compiled anyway
+    auto prefetched = prefetchSchemas("Problem3d", {ROOT_DIR + "/test/schema/complex_case"}, true, 2);
+    EXPECT_FALSE(prefetched.get());
+
+    std::stringstream log;
+    EXPECT_TRUE(getCompiledSchema("Problem3d", {ROOT_DIR + "/test/schema/complex_case"}, log));
+    EXPECT_TRUE(getCompiledSchema("SensorBase.schema", {ROOT_DIR + "/test/schema/complex_case"}, log));
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,128 @@
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/yaml_server.hpp"
+#include "yaml-schema-cpp/yaml_stream.hpp"
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+bool applySchemaLoading(const std::string& path_input, const std::string& name_schema)
+{
+    YamlServer server({ROOT_DIR + "/test/schema"}, path_input);
+    return server.applySchema(name_schema);
+}
+
+TEST(stream, same_validity_as_applySchema)
+{
+    std::vector<std::pair<std::string, std::string>> cases{{"base_input.yaml", "base_input"},
+                                                           {"own_type/single_mandatory.yaml", "single_mandatory"},
+                                                           {"own_type/sequence_mandatory.yaml", "sequence_mandatory"},
+                                                           {"expression_input1.yaml", "expression"},
+                                                           {"expression_input2.yaml", "expression"},
+                                                           {"expression_input_wrong1.yaml", "expression"},
+                                                           {"expression_input_wrong2.yaml", "expression"},
+                                                           {"duplicated_input.yaml", "base_input"}};  // follow
+    for (auto i = 1; i <= 10; i++) cases.emplace_back("base_input_wrong" + std::to_string(i) + ".yaml", "base_input");
+
+    for (auto test_case : cases)
+    {
+        auto path_input = ROOT_DIR + "/test/yaml/" + test_case.first;
+
+        std::stringstream log;
+        YAML::Node        node_output;
+        bool              is_valid =
+            applySchemaStream(path_input, test_case.second, {ROOT_DIR + "/test/schema"}, log, node_output);
+
+        EXPECT_EQ(is_valid, applySchemaLoading(path_input, test_case.second)) << test_case.first << "\n" << log.str();
+    }
+}
+
+TEST(stream, keep)
+{
+    std::stringstream log;
+    YAML::Node        node_output;
+    ASSERT_TRUE(applySchemaStream(ROOT_DIR + "/test/yaml/own_type/sequence_mandatory.yaml",
+                                  "sequence_mandatory",
+                                  {ROOT_DIR + "/test/schema"},
+                                  log,
+                                  node_output,
+                                  {"own_type"}));
+
+    // kept field, completed with defaults
+    ASSERT_TRUE(node_output["own_type"].IsSequence());
+    ASSERT_EQ(node_output["own_type"].size(), 2);
+    ASSERT_DOUBLE_EQ(node_output["own_type"][0]["map1"]["param3"].as<double>(), 3.5);
+    ASSERT_DOUBLE_EQ(node_output["own_type"][1]["map1"]["param3"].as<double>(), 4.4);
+    ASSERT_EQ(node_output["own_type"][0]["param4"].as<std::string>(), "hello");
+    ASSERT_EQ(node_output["own_type"][1]["param4"].as<std::string>(), "gromenauer");
+
+    // nested fields and defaults of missing fields
+    ASSERT_TRUE(applySchemaStream(ROOT_DIR + "/test/yaml/base_input.yaml",
+                                  "base_input",
+                                  {ROOT_DIR + "/test/schema"},
+                                  log,
+                                  node_output,
+                                  {"map1/param3", "param4", "param8"}));
+    ASSERT_DOUBLE_EQ(node_output["map1"]["param3"].as<double>(), 3.5);
+    ASSERT_EQ(node_output["param4"].as<std::string>(), "hello");
+    ASSERT_EQ(node_output["param8"].size(), 3);
+    ASSERT_FALSE(node_output["map1"]["param1"]);  // not kept
+    ASSERT_FALSE(node_output["param5"]);          // not kept
+}
+
+TEST(stream, large_array)
+{
+    // long sequence of a custom type, validated element by element
+    std::stringstream input;
+    input << "own_type:\n";
+    for (auto i = 0; i < 10000; i++)
+        input << "  - map1: {param1: " << i << ", param2: " << (i % 2 ? "strong" : "string") << "}\n";
+
+    std::stringstream log;
+    YAML::Node        node_output;
+    ASSERT_TRUE(applySchemaStream(input, "", "sequence_mandatory", {ROOT_DIR + "/test/schema"}, log, node_output));
+    ASSERT_FALSE(node_output.IsDefined() and node_output.size() != 0);
+
+    // wrong element
+    input.str("");
+    input.clear();
+    input << "own_type:\n";
+    for (auto i = 0; i < 100; i++)
+        input << "  - map1: {param1: " << i << ", param2: " << (i == 42 ? "strang" : "string") << "}\n";
+
+    log.str("");
+    ASSERT_FALSE(applySchemaStream(input, "", "sequence_mandatory", {ROOT_DIR + "/test/schema"}, log, node_output));
+    ASSERT_NE(log.str().find("own_type[42]/map1/param2"), std::string::npos);
+}
+
+TEST(stream, wrong_size)
+{
+    std::stringstream input("map1:\n  param1: 1\n  param2: string\nparam5: [1, 2, 3]\n");
+
+    std::stringstream log;
+    YAML::Node        node_output;
+    ASSERT_FALSE(applySchemaStream(input, "", "base_input", {ROOT_DIR + "/test/schema"}, log, node_output));
+    ASSERT_NE(log.str().find("param5"), std::string::npos);
+}
+
+TEST(stream, follow)
+{
+    // documents with 'follow' are loaded entirely, with the same result
+    std::stringstream log;
+    YAML::Node        node_output;
+    ASSERT_TRUE(applySchemaStream(ROOT_DIR + "/test/yaml/duplicated_input.yaml",
+                                  "base_input",
+                                  {ROOT_DIR + "/test/schema"},
+                                  log,
+                                  node_output,
+                                  {"map1"}));
+    ASSERT_EQ(node_output["map1"]["param2"].as<std::string>(), "string");
+    ASSERT_DOUBLE_EQ(node_output["map1"]["param3"].as<double>(), 4.5);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
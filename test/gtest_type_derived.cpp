@@ -1,6 +1,8 @@
 #include "gtest/utils_gtest.h"
 #include "yaml-schema-cpp/internal/config.h"
 #include "yaml-schema-cpp/yaml_server.hpp"
+#include "yaml-schema-cpp/yaml_schema.hpp"
+#include "yaml-schema-cpp/schema_cache.hpp"
 
 std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
 
@@ -55,6 +57,12 @@ TEST(TestTypeDerived, sequence_derived)
 
     std::cout << "after sequence_derived.schema: \n" << server.getNode() << std::endl;
     std::cout << "log: \n" << server.getLog() << std::endl;
+
+    // the schema is not modified by the validation of the sequence of derived
+    std::stringstream log;
+    auto              compiled_schema = getCompiledSchema("sequence_derived.schema", {ROOT_DIR}, log);
+    ASSERT_EQ(compiled_schema->node["processors"][TYPE].as<std::string>(), "derived[3]");
+    ASSERT_EQ(compiled_schema->node["sensors"][TYPE].as<std::string>(), "derived[]");
 }
 
 TEST(TestTypeDerived, sequence_derived_wrong)
@@ -0,0 +1,101 @@
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/validation_session.hpp"
+#include "yaml-schema-cpp/yaml_server.hpp"
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+TEST(validation_session, batch_files)
+{
+    std::vector<std::string> paths_input{ROOT_DIR + "/test/yaml/base_input.yaml",
+                                         ROOT_DIR + "/test/yaml/duplicated_input.yaml",
+                                         ROOT_DIR + "/test/yaml/not_existing.yaml"};
+    for (auto i = 1; i <= 10; i++)
+        paths_input.push_back(ROOT_DIR + "/test/yaml/base_input_wrong" + std::to_string(i) + ".yaml");
+
+    ValidationSession session({ROOT_DIR + "/test/schema"});
+    auto              results = session.applySchemaBatch(paths_input, "base_input");
+    ASSERT_EQ(results.size(), paths_input.size());
+
+    // not existing file
+    EXPECT_EQ(results[2].path_input, paths_input[2]);
+    EXPECT_FALSE(results[2].is_valid);
+    EXPECT_NE(results[2].log.find("not_existing.yaml"), std::string::npos);
+
+    // same as YamlServer
+    for (auto i = 0; i < results.size(); i++)
+    {
+        if (i == 2) continue;
+
+        YamlServer server({ROOT_DIR + "/test/schema"}, paths_input[i]);
+        EXPECT_EQ(results[i].path_input, paths_input[i]);
+        EXPECT_EQ(results[i].is_valid, server.applySchema("base_input")) << paths_input[i] << "\n" << results[i].log;
+        EXPECT_EQ(YAML::Dump(results[i].node), YAML::Dump(server.getNode())) << paths_input[i];
+    }
+}
+
+TEST(validation_session, batch_nodes)
+{
+    std::vector<YAML::Node> nodes_input;
+    for (auto i = 0; i < 20; i++)
+        nodes_input.push_back(YAML::Load("map1: {param1: " + std::to_string(i) + ", param2: " +
+                                         (i % 5 == 0 ? "strang" : "string") + "}\nparam5: [1, 2, 3, 4, 5]"));
+
+    ValidationSession session({ROOT_DIR + "/test/schema"}, true, 3);
+    auto              results = session.applySchemaBatch(nodes_input, "base_input");
+    ASSERT_EQ(results.size(), nodes_input.size());
+    for (auto i = 0; i < results.size(); i++)
+    {
+        EXPECT_TRUE(results[i].path_input.empty());
+        EXPECT_EQ(results[i].is_valid, i % 5 != 0) << results[i].log;
+
+        // completed with defaults, input nodes not modified
+        EXPECT_DOUBLE_EQ(results[i].node["map1"]["param3"].as<double>(), 3.5);
+        EXPECT_FALSE(nodes_input[i]["map1"]["param3"]);
+    }
+    EXPECT_NE(results[5].log.find("map1/param2"), std::string::npos);
+
+    // not existing schema
+    results = session.applySchemaBatch(nodes_input, "not_existing_schema");
+    for (auto result : results) EXPECT_FALSE(result.is_valid);
+}
+
+TEST(validation_session, fail_fast)
+{
+    std::vector<std::string> paths_input{ROOT_DIR + "/test/yaml/base_input.yaml",
+                                         ROOT_DIR + "/test/yaml/base_input_wrong1.yaml",
+                                         ROOT_DIR + "/test/yaml/base_input.yaml",
+                                         ROOT_DIR + "/test/yaml/base_input.yaml"};
+
+    // sequential: all files after the wrong one skipped
+    ValidationSession session({ROOT_DIR + "/test/schema"}, true, 1);
+    auto              results = session.applySchemaBatch(paths_input, "base_input", true);
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_TRUE(results[0].is_valid);
+    EXPECT_FALSE(results[0].is_skipped);
+    EXPECT_GT(results[0].time, 0);
+    EXPECT_FALSE(results[1].is_valid);
+    EXPECT_FALSE(results[1].is_skipped);
+    for (auto i = 2; i < 4; i++)
+    {
+        EXPECT_FALSE(results[i].is_valid);
+        EXPECT_TRUE(results[i].is_skipped);
+        EXPECT_EQ(results[i].path_input, paths_input[i]);
+    }
+
+    // without fail fast
+    results = session.applySchemaBatch(paths_input, "base_input");
+    for (auto i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(results[i].is_valid, i != 1);
+        EXPECT_FALSE(results[i].is_skipped);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,139 @@
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+#include "gtest/utils_gtest.h"
+#include "yaml-schema-cpp/filesystem_wrapper.hpp"
+#include "yaml-schema-cpp/internal/config.h"
+#include "yaml-schema-cpp/yaml_server.hpp"
+
+std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
+
+using namespace yaml_schema_cpp;
+
+TEST(yaml_server, state)
+{
+    YamlServer server({ROOT_DIR + "/test/schema"}, ROOT_DIR + "/test/yaml/base_input.yaml");
+    EXPECT_FALSE(server.getNode()["map1"]["param3"]);  // not applied yet
+    EXPECT_TRUE(server.getLog().empty());
+
+    // applySchema fills defaults and the log
+    EXPECT_TRUE(server.applySchema("base_input"));
+    EXPECT_DOUBLE_EQ(server.getNode()["map1"]["param3"].as<double>(), 3.5);
+    EXPECT_NE(server.getLog().find("schema: base_input"), std::string::npos);
+
+    // getNode returns a copy
+    auto node              = server.getNode();
+    node["map1"]["param3"] = 0.0;
+    EXPECT_DOUBLE_EQ(server.getNode()["map1"]["param3"].as<double>(), 3.5);
+
+    // folders
+    server.addFolderSchema(ROOT_DIR + "/test/yaml", true);
+    ASSERT_EQ(server.getFolderSchema().size(), 2);
+    EXPECT_EQ(server.getFolderSchema().front(), ROOT_DIR + "/test/yaml");
+
+    // failed load does not change the state
+    EXPECT_THROW(server.loadYaml(ROOT_DIR + "/test/yaml/not_existing.yaml"), std::runtime_error);
+    EXPECT_DOUBLE_EQ(server.getNode()["map1"]["param3"].as<double>(), 3.5);
+
+    // moved
+    YamlServer server_moved = std::move(server);
+    EXPECT_DOUBLE_EQ(server_moved.getNode()["map1"]["param3"].as<double>(), 3.5);
+}
+
+TEST(yaml_server, concurrent_readers)
+{
+    YamlServer server({ROOT_DIR + "/test/schema"}, ROOT_DIR + "/test/yaml/base_input.yaml");
+
+    // readers always see a complete state: loaded (without param3) or validated (with param3)
+    std::atomic<bool>        done(false);
+    std::atomic<int>         wrong(0);
+    std::vector<std::thread> readers;
+    for (auto i = 0; i < 4; i++)
+    {
+        readers.emplace_back([&]() {
+            while (not done)
+            {
+                auto node = server.getNode();
+                if (not node["map1"] or not node["map1"]["param1"]) wrong++;
+                if (node["map1"]["param3"] and node["map1"]["param3"].as<double>() != 3.5) wrong++;
+                server.getLog();
+                server.getFolderSchema();
+            }
+        });
+    }
+
+    // writer
+    for (auto i = 0; i < 20; i++)
+    {
+        server.loadYaml(ROOT_DIR + "/test/yaml/base_input.yaml");
+        EXPECT_TRUE(server.applySchema("base_input"));
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(wrong, 0);
+}
+
+TEST(yaml_server, validation_cache)
+{
+    auto folder = (filesystem::temp_directory_path() / "yaml_schema_cpp_validation_cache").string();
+    filesystem::remove_all(folder);
+    filesystem::create_directories(folder + "/input");
+    std::ofstream(folder + "/input/input.yaml") << "param4: bye\nfollow: included.yaml\n";
+    std::ofstream(folder + "/input/included.yaml") << "map1:\n  param1: 1\n  param2: string\n";
+
+    // stored
+    YamlServer server({ROOT_DIR + "/test/schema"});
+    server.setValidationCache(folder + "/cache");
+    EXPECT_EQ(server.getValidationCache(), folder + "/cache");
+    ASSERT_TRUE(server.loadAndApplySchema(folder + "/input/input.yaml", "base_input"));
+    EXPECT_DOUBLE_EQ(server.getNode()["map1"]["param3"].as<double>(), 3.5);
+
+    std::vector<std::string> paths_cache;
+    for (auto const& entry : filesystem::directory_iterator(folder + "/cache"))
+        paths_cache.push_back(entry.path().string());
+    ASSERT_EQ(paths_cache.size(), 1);  // no temporary files left
+
+    // input and followed file, with the hash of the contents validated
+    auto node_files = YAML::LoadFile(paths_cache.front())["files"];
+    ASSERT_EQ(node_files.size(), 2);
+    EXPECT_EQ(node_files[0]["path"].as<std::string>(), filesystem::absolute(folder + "/input/input.yaml").string());
+    EXPECT_EQ(node_files[1]["path"].as<std::string>(), filesystem::absolute(folder + "/input/included.yaml").string());
+    EXPECT_EQ(node_files[1]["hash"].as<std::string>(), hashContents("map1:\n  param1: 1\n  param2: string\n"));
+
+    // loaded from the cache (modified to check it is not validated again)
+    auto node_cache   = YAML::LoadFile(paths_cache.front());
+    node_cache["log"] = "from cache";
+    std::ofstream(paths_cache.front()) << node_cache;
+
+    YamlServer server_cached({ROOT_DIR + "/test/schema"});
+    server_cached.setValidationCache(folder + "/cache");
+    ASSERT_TRUE(server_cached.loadAndApplySchema(folder + "/input/input.yaml", "base_input"));
+    EXPECT_EQ(server_cached.getLog(), "from cache");
+    EXPECT_EQ(server_cached.getNode()["param4"].as<std::string>(), "bye");
+    EXPECT_DOUBLE_EQ(server_cached.getNode()["map1"]["param3"].as<double>(), 3.5);
+
+    // followed file modified: validated again
+    std::ofstream(folder + "/input/included.yaml") << "map1:\n  param1: 1\n  param2: strang\n";
+    EXPECT_FALSE(server_cached.loadAndApplySchema(folder + "/input/input.yaml", "base_input"));
+    EXPECT_NE(server_cached.getLog().find("map1/param2"), std::string::npos);
+
+    // invalid result also cached
+    YamlServer server_invalid({ROOT_DIR + "/test/schema"});
+    server_invalid.setValidationCache(folder + "/cache");
+    EXPECT_FALSE(server_invalid.loadAndApplySchema(folder + "/input/input.yaml", "base_input"));
+    EXPECT_EQ(server_invalid.getLog(), server_cached.getLog());
+
+    // without cache
+    YamlServer server_no_cache({ROOT_DIR + "/test/schema"});
+    EXPECT_FALSE(server_no_cache.loadAndApplySchema(folder + "/input/input.yaml", "base_input"));
+
+    filesystem::remove_all(folder);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
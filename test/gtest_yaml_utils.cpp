@@ -1,6 +1,7 @@
 #include "gtest/utils_gtest.h"
 #include "yaml-schema-cpp/internal/config.h"
 #include "yaml-schema-cpp/yaml_utils.hpp"
+#include "yaml-schema-cpp/yaml_hash.hpp"
 
 std::string ROOT_DIR = _YAML_SCHEMA_CPP_ROOT_DIR;
 
@@ -49,6 +50,21 @@ TEST(TestYamlUtils, getLowestElementType)
     EXPECT_EQ(getLowestElementType("double[23487][5]"), "double");
 }
 
+TEST(TestYamlUtils, isRelativePathPrefix)
+{
+    ASSERT_TRUE(isRelativePathPrefix("./file.yaml"));
+    ASSERT_TRUE(isRelativePathPrefix("../file.yaml"));
+    ASSERT_TRUE(isRelativePathPrefix("./"));
+    ASSERT_TRUE(isRelativePathPrefix("../"));
+    ASSERT_FALSE(isRelativePathPrefix(""));
+    ASSERT_FALSE(isRelativePathPrefix("."));
+    ASSERT_FALSE(isRelativePathPrefix(".."));
+    ASSERT_FALSE(isRelativePathPrefix("..."));
+    ASSERT_FALSE(isRelativePathPrefix(".hidden/file"));
+    ASSERT_FALSE(isRelativePathPrefix("/abs/./file"));
+    ASSERT_FALSE(isRelativePathPrefix("folder/../file"));
+}
+
 TEST(compare, compare_trivial)
 {
     /*
@@ -100,6 +116,29 @@ TEST(compare, compare_trivial)
     EXPECT_TRUE(compare(node_input["param8"], node_input["param8"], "float[3][]", {}));
 }
 
+#if _EIGEN_FOUND == 1
+TEST(compare, compare_eigen)
+{
+    auto node_v3    = YAML::Load("[1, 2, 3]");
+    auto node_v3_b  = YAML::Load("[[3, 1], [1, 2.0, 3.0]]");
+    auto node_v3_c  = YAML::Load("[1, 2, 3.1]");
+    auto node_m23   = YAML::Load("[[2, 3], [1, 2, 3, 4, 5, 6]]");
+    auto node_m32   = YAML::Load("[[3, 2], [1, 2, 3, 4, 5, 6]]");
+    auto node_wrong = YAML::Load("[1, a, 3]");
+
+    EXPECT_TRUE(compare(node_v3, node_v3_b, "Vector3d", {}));
+    EXPECT_TRUE(compare(node_v3, node_v3_b, "Eigen::VectorXd", {}));
+    EXPECT_TRUE(compare(node_v3, YAML::Load("[1, 2, 3.0000000000001]"), "Vector3d", {}));  // tolerance
+    EXPECT_FALSE(compare(node_v3, node_v3_c, "Vector3d", {}));
+    EXPECT_FALSE(compare(node_v3, node_v3_c, "VectorXd", {}));
+    EXPECT_FALSE(compare(node_v3, node_wrong, "Vector3d", {}));
+    EXPECT_FALSE(compare(node_wrong, node_wrong, "Vector3d", {}));
+    EXPECT_FALSE(compare(node_v3, YAML::Load("[1, 2]"), "VectorXd", {}));
+    EXPECT_TRUE(compare(node_m23, node_m23, "MatrixXd", {}));
+    EXPECT_FALSE(compare(node_m23, node_m32, "MatrixXd", {}));  // same values, different size
+}
+#endif
+
 TEST(compare, compare_non_trivial)
 {
     // base_input
@@ -241,6 +280,37 @@ TEST(compare, compare_nodes_auto_type)
     EXPECT_FALSE(compareNodesAutoType(node_input, node_comp));
 }
 
+TEST(compare, structural_hash)
+{
+    NodeHasher hasher;
+
+    // numbers by value
+    EXPECT_EQ(hasher.hash(YAML::Load("1e3")), hasher.hash(YAML::Load("1000")));
+    EXPECT_EQ(hasher.hash(YAML::Load("1000.0")), hasher.hash(YAML::Load("1000")));
+    EXPECT_EQ(hasher.hash(YAML::Load("-0.0")), hasher.hash(YAML::Load("0")));
+    EXPECT_TRUE(compareNodesAutoType(YAML::Load("1e3"), YAML::Load("1000")));
+
+    // maps independent of key order, sequences not
+    YAML::Node map1 = YAML::Load("{a: 1, b: [1, 2, {c: x, d: 2.0}], e: ~}");
+    YAML::Node map2 = YAML::Load("{e: ~, b: [1, 2e0, {d: 2, c: x}], a: 1.0}");
+    YAML::Node map3 = YAML::Load("{e: ~, b: [2, 1, {d: 2, c: x}], a: 1.0}");
+    EXPECT_EQ(hasher.hash(map1), hasher.hash(map2));
+    EXPECT_NE(hasher.hash(map1), hasher.hash(map3));
+    EXPECT_TRUE(hasher.equal(map1, map2));
+    EXPECT_FALSE(hasher.equal(map1, map3));
+    EXPECT_TRUE(compareNodesAutoType(map1, map2));
+    EXPECT_FALSE(compareNodesAutoType(map2, map3));
+
+    // strings
+    EXPECT_FALSE(compareNodesAutoType(YAML::Load("{a: x}"), YAML::Load("{a: y}")));
+    EXPECT_FALSE(compareNodesAutoType(YAML::Load("{a: x}"), YAML::Load("{b: x}")));
+
+    // hashes cached for all subtrees
+    auto hash_b = hasher.hash(map1["b"]);
+    EXPECT_EQ(hash_b, hasher.hash(map2["b"]));
+    EXPECT_NE(hash_b, hasher.hash(map1["a"]));
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);